@@ -0,0 +1,714 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: bench.c                                                            |
+| project:  ZX Spectrum Next - PING                                            |
+| author:   Stefan Zell                                                        |
+| date:     16/10/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Microbenchmark harness for the stages of the probe loop in "ping()"          |
+|                                                                              |
+| The harness is compiled once per stage (-DBENCH_STAGE_xxx) for the z88dk     |
+| target "+test" and executed by "z88dk-ticks" (see "bench.sh"). The ESP8266   |
+| is replaced by canned responses.                                             |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 16/10/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+/* The application is compiled as part of the harness to reach its statics */
+#define main app_main
+#include "../src/main.c"
+#undef main
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+Number of executions of the stage; the cycles per stage are calculated by
+"bench.sh" as (ticks(stage) - ticks(empty)) / uiBENCH_LOOPS
+*/
+#if !defined(uiBENCH_LOOPS)
+  #define uiBENCH_LOOPS (64)
+#endif
+
+/*!
+Host that is used for all stages
+*/
+#define sBENCH_HOST "192.168.100.200"
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+/*!
+Canned response of the ESP8266 to "AT+PING"
+*/
+static const char_t g_acResponse[] = "+23\r\n\r\nOK\r\n";
+
+/*!
+Number of bytes of the canned response
+*/
+#define uiBENCH_RESPONSE (sizeof(g_acResponse) - 1)
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+/*!
+Sink of all transmitted bytes (replaces the UART TX register)
+*/
+static volatile uint8_t g_uiSink;
+
+/*!
+Index of the next byte of the canned response
+*/
+static uint8_t g_uiPos;
+
+/*!
+Resident memory (replaces the arena of NextOS pages)
+*/
+static uint8_t g_auiArena[0x0400];
+
+/*!
+Used bytes of the resident memory
+*/
+static uint16_t g_uiArena;
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/* esp_open()                                                                 */
+/*----------------------------------------------------------------------------*/
+int esp_open(esp_t* pEsp)
+{
+  (void) pEsp;
+  return EOK;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* esp_close()                                                                */
+/*----------------------------------------------------------------------------*/
+int esp_close(esp_t* pEsp)
+{
+  (void) pEsp;
+  return EOK;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* esp_flush()                                                                */
+/*----------------------------------------------------------------------------*/
+int esp_flush(esp_t* pEsp)
+{
+  (void) pEsp;
+  g_uiPos = 0;
+  return EOK;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* esp_transmit()                                                             */
+/*----------------------------------------------------------------------------*/
+int esp_transmit(esp_t* pEsp, const char_t* acCmd)
+{
+  (void) pEsp;
+
+  while ('\0' != *acCmd)
+  {
+    g_uiSink = (uint8_t) *acCmd++;
+  }
+
+  return EOK;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* esprx_init()                                                               */
+/*----------------------------------------------------------------------------*/
+void esprx_init(void)
+{
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* esprx_exit()                                                               */
+/*----------------------------------------------------------------------------*/
+void esprx_exit(void)
+{
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* esprx_flush()                                                              */
+/*----------------------------------------------------------------------------*/
+void esprx_flush(void)
+{
+  g_uiPos = 0;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* esprx_getc()                                                               */
+/*----------------------------------------------------------------------------*/
+int esprx_getc(void)
+{
+  uint8_t uiByte = (uint8_t) g_acResponse[g_uiPos];
+
+  if (++g_uiPos >= uiBENCH_RESPONSE)
+  {
+    g_uiPos = 0;
+  }
+
+  return uiByte;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* esprx_stats()                                                              */
+/*----------------------------------------------------------------------------*/
+const esprx_stats_t* esprx_stats(void)
+{
+  static esprx_stats_t tStats;
+  return &tStats;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* zxn_getspeed()                                                             */
+/*----------------------------------------------------------------------------*/
+uint8_t zxn_getspeed(void)
+{
+  return RTM_3MHZ;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* zxn_setspeed()                                                             */
+/*----------------------------------------------------------------------------*/
+void zxn_setspeed(uint8_t uiSpeed)
+{
+  (void) uiSpeed;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* zxn_sleep_ms()                                                             */
+/*----------------------------------------------------------------------------*/
+void zxn_sleep_ms(uint16_t uiTime)
+{
+  (void) uiTime;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* zxn_rtrim()                                                                */
+/*----------------------------------------------------------------------------*/
+char_t* zxn_rtrim(char_t* acString)
+{
+  return acString;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* zxn_strerror()                                                             */
+/*----------------------------------------------------------------------------*/
+int zxn_strerror(int iCode)
+{
+  return iCode;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* in_inkey()                                                                 */
+/*----------------------------------------------------------------------------*/
+int in_inkey(void)
+{
+  return 0;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* in_key_pressed()                                                           */
+/*----------------------------------------------------------------------------*/
+int in_key_pressed(uint16_t uiScancode)
+{
+  (void) uiScancode;
+  return 0;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* esx_m_dosversion()                                                         */
+/*----------------------------------------------------------------------------*/
+uint16_t esx_m_dosversion(void)
+{
+  return 0x0207;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* reclog_open()                                                              */
+/*----------------------------------------------------------------------------*/
+int reclog_open(const char* acFile, uint16_t uiInterval, bool bFixedRate)
+{
+  (void) acFile;
+  (void) uiInterval;
+  (void) bFixedRate;
+  return EOK;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* reclog_add()                                                               */
+/*----------------------------------------------------------------------------*/
+int reclog_add(uint16_t uiSeq, uint16_t uiRtt, uint8_t uiResult)
+{
+  (void) uiSeq;
+  (void) uiRtt;
+  (void) uiResult;
+  return EOK;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* reclog_close()                                                             */
+/*----------------------------------------------------------------------------*/
+int reclog_close(void)
+{
+  return EOK;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* espbaud_set()                                                              */
+/*----------------------------------------------------------------------------*/
+void espbaud_set(uint32_t uiBaud)
+{
+  (void) uiBaud;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* espbaud_get()                                                              */
+/*----------------------------------------------------------------------------*/
+uint32_t espbaud_get(void)
+{
+  return uiESPBAUD_DEFAULT;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* bankmem_init()                                                             */
+/*----------------------------------------------------------------------------*/
+int bankmem_init(void)
+{
+  return EOK;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* bankmem_exit()                                                             */
+/*----------------------------------------------------------------------------*/
+void bankmem_exit(void)
+{
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* bankmem_alloc()                                                            */
+/*----------------------------------------------------------------------------*/
+void* bankmem_alloc(uint16_t uiSize)
+{
+  void* pReturn = 0;
+
+  if (uiSize <= (sizeof(g_auiArena) - g_uiArena))
+  {
+    pReturn = &g_auiArena[g_uiArena];
+    g_uiArena += uiSize;
+  }
+
+  return pReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* bankmem_falloc()                                                           */
+/*----------------------------------------------------------------------------*/
+bankmem_t bankmem_falloc(uint16_t uiSize)
+{
+  (void) uiSize;
+  return uiBANKMEM_NULL;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* bankmem_map()                                                              */
+/*----------------------------------------------------------------------------*/
+void* bankmem_map(bankmem_t tAddr)
+{
+  (void) tAddr;
+  return 0;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* bankmem_unmap()                                                            */
+/*----------------------------------------------------------------------------*/
+void bankmem_unmap(void)
+{
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* dnscache_lookup()                                                          */
+/*----------------------------------------------------------------------------*/
+bool dnscache_lookup(const char* acName, char* acAddr)
+{
+  (void) acName;
+  (void) acAddr;
+  return false;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* dnscache_store()                                                           */
+/*----------------------------------------------------------------------------*/
+int dnscache_store(const char* acName, const char* acAddr)
+{
+  (void) acName;
+  (void) acAddr;
+  return EOK;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* dash_init()                                                                */
+/*----------------------------------------------------------------------------*/
+void dash_init(void)
+{
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* dash_column()                                                              */
+/*----------------------------------------------------------------------------*/
+void dash_column(uint16_t uiIndex, bool bOk, uint16_t uiRtt)
+{
+  (void) uiIndex;
+  (void) bOk;
+  (void) uiRtt;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* dash_counter()                                                             */
+/*----------------------------------------------------------------------------*/
+void dash_counter(dash_counter_t eCounter, uint16_t uiValue)
+{
+  (void) eCounter;
+  (void) uiValue;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* monitor_pause()                                                            */
+/*----------------------------------------------------------------------------*/
+bool monitor_pause(bool bPause)
+{
+  (void) bPause;
+  return false;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* monitor_start()                                                            */
+/*----------------------------------------------------------------------------*/
+int monitor_start(const char* acCmd, uint32_t uiAddr, uint16_t uiInterval)
+{
+  (void) acCmd;
+  (void) uiAddr;
+  (void) uiInterval;
+  return ENOTSUP;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* monitor_uninstall()                                                        */
+/*----------------------------------------------------------------------------*/
+int monitor_uninstall(void)
+{
+  return ENOTSUP;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* monitor_block()                                                            */
+/*----------------------------------------------------------------------------*/
+const monitor_block_t* monitor_block(void)
+{
+  static monitor_block_t tBlock;
+  return &tBlock;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* hostlist_open()                                                            */
+/*----------------------------------------------------------------------------*/
+int hostlist_open(const char* acFile)
+{
+  (void) acFile;
+  return ENOTSUP;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* hostlist_next()                                                            */
+/*----------------------------------------------------------------------------*/
+bool hostlist_next(char* acHost, uint16_t uiSize, uint16_t* puiCount)
+{
+  (void) acHost;
+  (void) uiSize;
+  (void) puiCount;
+  return false;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* hostlist_close()                                                           */
+/*----------------------------------------------------------------------------*/
+void hostlist_close(void)
+{
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* espready_load()                                                            */
+/*----------------------------------------------------------------------------*/
+bool espready_load(espready_t* pReady)
+{
+  (void) pReady;
+  return false;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* espready_store()                                                           */
+/*----------------------------------------------------------------------------*/
+int espready_store(const espready_t* pReady)
+{
+  (void) pReady;
+  return EOK;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* espcap_open()                                                              */
+/*----------------------------------------------------------------------------*/
+int espcap_open(const char* acFile)
+{
+  (void) acFile;
+  return ENOTSUP;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* espcap_tx()                                                                */
+/*----------------------------------------------------------------------------*/
+void espcap_tx(const char* acCmd)
+{
+  (void) acCmd;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* espcap_rx()                                                                */
+/*----------------------------------------------------------------------------*/
+void espcap_rx(uint8_t uiByte)
+{
+  (void) uiByte;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* espcap_close()                                                             */
+/*----------------------------------------------------------------------------*/
+int espcap_close(void)
+{
+  return EOK;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* statexp_write()                                                            */
+/*----------------------------------------------------------------------------*/
+void statexp_write(const statexp_t* pBlock, uint8_t uiBank, uint16_t uiAddr)
+{
+  (void) pBlock;
+  (void) uiBank;
+  (void) uiAddr;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* statexp_basic()                                                            */
+/*----------------------------------------------------------------------------*/
+bool statexp_basic(const statexp_t* pBlock, uint8_t uiVar)
+{
+  (void) pBlock;
+  (void) uiVar;
+  return true;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* timer_init()                                                               */
+/*----------------------------------------------------------------------------*/
+void timer_init(void)
+{
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* timer_exit()                                                               */
+/*----------------------------------------------------------------------------*/
+void timer_exit(void)
+{
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* timer_now()                                                                */
+/*----------------------------------------------------------------------------*/
+uint32_t timer_now(void)
+{
+  return 0;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* timer_from_ms()                                                            */
+/*----------------------------------------------------------------------------*/
+uint32_t timer_from_ms(uint32_t uiMs)
+{
+  return uiMs * uiTIMER_TICKS_PER_MS;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* timer_to_100us()                                                           */
+/*----------------------------------------------------------------------------*/
+uint32_t timer_to_100us(uint32_t uiTicks)
+{
+  return uiTicks;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* timer_wait_until()                                                         */
+/*----------------------------------------------------------------------------*/
+void timer_wait_until(uint32_t uiDeadline)
+{
+  (void) uiDeadline;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* main()                                                                     */
+/*----------------------------------------------------------------------------*/
+int main(void)
+{
+  uint16_t i;
+ #if defined(BENCH_STAGE_RECEIVE) || defined(BENCH_STAGE_PARSE)
+  uint8_t j;
+ #endif
+
+  _construct();
+
+  fmt_format(g_tState.acHost, uiMAX_HOST_NAME, "%s", sBENCH_HOST);
+  fmt_format(g_tState.esp.acTxBuffer, uiMAX_LEN_CMD, sCMD_AT_PING "=\"%s\"\r\n", g_tState.acHost);
+  resetStatistics();
+  at_reset(&g_tState.tParser);
+  esp_flush(&g_tState.tEsp);
+
+  for (i = 0; i < uiBENCH_LOOPS; ++i)
+  {
+   #if defined(BENCH_STAGE_COMMAND)
+    fmt_format(g_tState.esp.acTxBuffer, uiMAX_LEN_CMD, sCMD_AT_PING "=\"%s\"\r\n", g_tState.acHost);
+   #elif defined(BENCH_STAGE_TRANSMIT)
+    esp_transmit(&g_tState.tEsp, g_tState.esp.acTxBuffer);
+   #elif defined(BENCH_STAGE_RECEIVE)
+    for (j = 0; j < uiBENCH_RESPONSE; ++j)
+    {
+      esprx_getc();
+    }
+   #elif defined(BENCH_STAGE_PARSE)
+    for (j = 0; j < uiBENCH_RESPONSE; ++j)
+    {
+      if (AT_EVENT_VALUE == at_parse(&g_tState.tParser, (uint8_t) g_acResponse[j]))
+      {
+        g_tState.stats.uiTime = g_tState.tParser.uiValue;
+      }
+    }
+   #elif defined(BENCH_STAGE_STATS)
+    g_tState.stats.uiTime = i;
+    updateStatistics();
+   #elif defined(BENCH_STAGE_PRINT)
+    app_printf(stdout, "response from %s: time=%u ms\n", g_tState.acHost, g_tState.stats.uiTime);
+   #elif !defined(BENCH_STAGE_EMPTY)
+    #error "unknown benchmark stage"
+   #endif
+  }
+
+  return 0;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
@@ -0,0 +1,86 @@
+#!/bin/sh
+#------------------------------------------------------------------------------
+# bench.sh - runs the stages of the probe loop under "z88dk-ticks"
+#
+# usage: bench.sh check|update stage ...
+#
+#  check   print cycles per stage and fail, if a stage needs more than
+#          BENCH_TOLERANCE percent (default: 5) cycles than in "baseline.txt"
+#  update  print cycles per stage and store them in "baseline.txt"
+#
+# The harness "bench.c" is compiled once per stage with the flags in
+# BENCH_CFLAGS and linked with the hardware independent sources in
+# BENCH_SRCS. The stage "empty" measures the overhead of the harness and is
+# subtracted from all other stages.
+#------------------------------------------------------------------------------
+
+MODE=$1
+shift
+
+BENCH_DIR=$(dirname "$0")
+BASELINE=$BENCH_DIR/baseline.txt
+LOOPS=${BENCH_LOOPS:-64}
+TOLERANCE=${BENCH_TOLERANCE:-5}
+ZCC=${ZCC:-zcc}
+TICKS=${TICKS:-z88dk-ticks}
+
+# Compile and run one stage; prints the total number of T-states
+run_stage()
+{
+  STAGE=$(echo "$1" | tr 'a-z' 'A-Z')
+  BIN=bench_$1.bin
+
+  $ZCC $BENCH_CFLAGS -DBENCH_STAGE_$STAGE -DuiBENCH_LOOPS=$LOOPS "$BENCH_DIR/bench.c" $BENCH_SRCS -o "$BIN" || return 1
+  $TICKS "$BIN" | sed -n 's/.*[Tt]icks[^0-9]*\([0-9][0-9]*\).*/\1/p' | tail -n 1
+}
+
+EMPTY=$(run_stage empty)
+
+if [ -z "$EMPTY" ]; then
+  echo "bench: unable to run stage \"empty\"" >&2
+  exit 1
+fi
+
+RESULT=0
+OUTPUT=""
+
+printf "%-10s %10s %10s\n" "stage" "cycles" "baseline"
+
+for STAGE in "$@"; do
+  [ "$STAGE" = "empty" ] && continue
+
+  TOTAL=$(run_stage "$STAGE")
+
+  if [ -z "$TOTAL" ]; then
+    echo "bench: unable to run stage \"$STAGE\"" >&2
+    exit 1
+  fi
+
+  CYCLES=$(( (TOTAL - EMPTY) / LOOPS ))
+  OUTPUT="$OUTPUT$STAGE $CYCLES
+"
+  BASE=""
+  if [ -f "$BASELINE" ]; then
+    BASE=$(sed -n "s/^$STAGE \([0-9][0-9]*\)$/\1/p" "$BASELINE")
+  fi
+
+  printf "%-10s %10s %10s" "$STAGE" "$CYCLES" "${BASE:--}"
+
+  if [ "$MODE" = "check" ] && [ -n "$BASE" ] && [ $(( CYCLES * 100 )) -gt $(( BASE * (100 + TOLERANCE) )) ]; then
+    printf "  REGRESSION\n"
+    RESULT=1
+  else
+    printf "\n"
+  fi
+done
+
+if [ "$MODE" = "update" ]; then
+  printf "%s" "$OUTPUT" > "$BASELINE"
+  echo "bench: baseline written to $BASELINE"
+elif [ ! -f "$BASELINE" ]; then
+  echo "bench: no baseline found; run \"make bench-baseline\" to create it"
+fi
+
+rm -f bench_*.bin
+
+exit $RESULT
@@ -0,0 +1,428 @@
+; +------------------------------------------------------------------------------+
+; |                                                                              |
+; | filename: pingmon.asm                                                        |
+; | project:  ZX Spectrum Next - PING                                            |
+; | author:   Stefan Zell                                                        |
+; | date:     16/10/2026                                                         |
+; |                                                                              |
+; +------------------------------------------------------------------------------+
+; |                                                                              |
+; | description:                                                                 |
+; |                                                                              |
+; | Resident background monitor (NextZXOS driver)                                |
+; |                                                                              |
+; | Pings one IP address while NextBASIC runs and publishes the statistics in    |
+; | a shared memory block (see "pingmon.inc"). NextZXOS calls the driver on      |
+; | each IM1 interrupt; one UART step is executed per interrupt: either the      |
+; | command is written to the UART or at most RX_PER_IRQ bytes of the            |
+; | response are parsed.                                                         |
+; |                                                                              |
+; | The code is assembled at 0 and relocated by NextZXOS; the high byte of       |
+; | each absolute address inside the driver is listed in the relocation          |
+; | table (labels r2_xx: address at +2, r3_xx: address at +3).                   |
+; |                                                                              |
+; +------------------------------------------------------------------------------+
+; |                                                                              |
+; | Copyright (c) 16/10/2026 STZ Engineering                                     |
+; |                                                                              |
+; | This software is provided  "as is",  without warranty of any kind, express   |
+; | or implied. In no event shall STZ or its contributors be held liable for any |
+; | direct, indirect, incidental, special or consequential damages arising out   |
+; | of the use of or inability to use this software.                             |
+; |                                                                              |
+; | Permission is granted to anyone  to use this  software for any purpose,      |
+; | including commercial applications,  and to alter it and redistribute it      |
+; | freely, subject to the following restrictions:                               |
+; |                                                                              |
+; | 1. Redistributions of source code must retain the above copyright            |
+; |    notice, definition, disclaimer, and this list of conditions.              |
+; |                                                                              |
+; | 2. Redistributions in binary form must reproduce the above copyright         |
+; |    notice, definition, disclaimer, and this list of conditions in            |
+; |    documentation and/or other materials provided with the distribution.      |
+; |                                                                          ;-) |
+; +------------------------------------------------------------------------------+
+
+                include "pingmon.inc"
+
+;==============================================================================
+;                              Defines
+;==============================================================================
+UART_STATUS     equ     $133b           ; read: status, write: transmit;
+                                        ; +$100: receive
+UART_SELECT     equ     $153b           ; bit 6: UART of the Raspberry Pi
+
+ST_RX_AVAIL     equ     $01
+ST_TX_FULL      equ     $02
+SELECT_PI       equ     $40
+
+RX_PER_IRQ      equ     16              ; max. bytes parsed per interrupt
+WAIT_FRAMES     equ     250             ; max. time for a response (5 s)
+DEFAULT_FRAMES  equ     50              ; default interval (1 s)
+
+LINE_START      equ     0               ; states of the parser
+LINE_NUMBER     equ     1               ; "+<rtt>"
+LINE_SKIP       equ     2
+LINE_OK         equ     3               ; "OK"
+LINE_ERROR      equ     4               ; "ERROR"
+LINE_FAIL       equ     5               ; "FAIL"
+
+NO_RTT          equ     $ffff
+
+;==============================================================================
+;                              Entry points
+;==============================================================================
+                org     $0000
+
+api_entry:                              ; $0000: API (M_DRVAPI, DRIVER)
+r2_01:          jp      api
+
+;==============================================================================
+;                              Interrupt
+;==============================================================================
+im1_entry:                              ; $0003: IM1 interrupt
+r2_02:          ld      a,(v_state)
+                or      a
+                ret     z                       ; stopped
+                ret     m                       ; application uses the ESP
+                ld      d,a
+                ld      bc,UART_SELECT
+                in      a,(c)
+                and     SELECT_PI
+                ret     nz
+r2_03:          ld      hl,(v_timer)
+                dec     hl
+r2_04:          ld      (v_timer),hl
+                ld      a,h
+                or      l
+                jr      z,irq_expired
+                ld      a,d
+                cp      STATE_WAIT
+                ret     nz
+
+                ld      e,RX_PER_IRQ            ; step: parse the response
+irq_receive:
+                ld      bc,UART_STATUS
+                in      a,(c)
+                and     ST_RX_AVAIL
+                ret     z
+                inc     b
+                in      a,(c)
+r2_05:          call    parse
+                jr      c,probe_done
+                dec     e
+                jr      nz,irq_receive
+                ret
+
+irq_expired:
+                ld      a,d
+                ld      d,RESULT_COMM
+                cp      STATE_WAIT
+                jr      z,probe_done
+
+r2_06:          ld      hl,v_cmd                ; step: send the command
+                ld      bc,UART_STATUS
+irq_send_byte:
+                in      a,(c)
+                and     ST_TX_FULL
+                jr      nz,irq_send_byte
+                ld      a,(hl)
+                out     (c),a
+                inc     hl
+                cp      $0a
+                jr      nz,irq_send_byte
+
+                ld      hl,(BLOCK+B_SENT)
+                inc     hl
+                ld      (BLOCK+B_SENT),hl
+                ld      hl,WAIT_FRAMES
+r2_07:          ld      (v_timer),hl
+                ld      hl,NO_RTT
+r2_08:          ld      (v_rtt),hl
+                xor     a
+r2_09:          ld      (v_line),a
+                ld      a,STATE_WAIT
+                jr      set_state
+
+;------------------------------------------------------------------------------
+; probe_done: updates the shared memory block; D = RESULT_xxx
+;------------------------------------------------------------------------------
+probe_done:
+                ld      a,d
+                ld      (BLOCK+B_RESULT),a
+                or      a
+                jr      z,probe_ok
+                ld      hl,(BLOCK+B_STREAK)
+                inc     hl
+                ld      (BLOCK+B_STREAK),hl
+                jr      set_idle
+probe_ok:
+                ld      hl,(BLOCK+B_RECEIVED)
+                inc     hl
+                ld      (BLOCK+B_RECEIVED),hl
+                ld      h,a
+                ld      l,a
+                ld      (BLOCK+B_STREAK),hl
+r3_10:          ld      de,(v_rtt)
+                ld      (BLOCK+B_RTT),de
+                ld      hl,(BLOCK+B_MIN)
+                and     a
+                sbc     hl,de
+                jr      c,probe_max
+                ld      (BLOCK+B_MIN),de
+probe_max:
+                ld      hl,(BLOCK+B_MAX)
+                and     a
+                sbc     hl,de
+                jr      nc,probe_avg
+                ld      (BLOCK+B_MAX),de
+probe_avg:
+                ld      hl,(BLOCK+B_RECEIVED)
+                dec     hl
+                ld      a,h
+                or      l
+                ex      de,hl                   ; HL = RTT
+                jr      z,probe_avg_set         ; first response
+                ld      de,(BLOCK+B_AVG)
+                and     a
+                sbc     hl,de
+                sra     h                       ; avg += (RTT - avg) / 8
+                rr      l
+                sra     h
+                rr      l
+                sra     h
+                rr      l
+                add     hl,de
+probe_avg_set:
+                ld      (BLOCK+B_AVG),hl
+
+;------------------------------------------------------------------------------
+; set_idle: waits the interval before the next probe
+;------------------------------------------------------------------------------
+set_idle:
+r2_11:          ld      hl,(v_interval)
+r2_12:          ld      (v_timer),hl
+                ld      a,STATE_IDLE
+
+;------------------------------------------------------------------------------
+; set_state: sets and publishes the state (A); CY = 0
+;------------------------------------------------------------------------------
+set_state:
+r2_13:          ld      (v_state),a
+                ld      (BLOCK+B_STATE),a
+                and     a
+                ret
+
+;==============================================================================
+;                              API
+;==============================================================================
+api:
+                ld      a,b
+                dec     a
+                jr      z,api_start             ; CALL_START
+                dec     a
+                jr      z,api_interval          ; CALL_INTERVAL
+                dec     a
+                jr      z,api_stop              ; CALL_STOP
+                dec     a
+                jr      z,api_pause             ; CALL_PAUSE
+                xor     a                       ; unknown call
+                scf
+                ret
+
+api_start:                              ; HL = command, terminated by '\n'
+r2_14:          ld      de,v_cmd
+                ld      b,CMD_SIZE
+api_start_copy:
+                ld      a,(hl)
+                ld      (de),a
+                inc     hl
+                inc     de
+                cp      $0a
+                jr      z,api_start_block
+                djnz    api_start_copy
+                xor     a                       ; command too long
+                scf
+                ret
+api_start_block:
+                ld      hl,BLOCK
+                ld      (hl),'P'
+                inc     hl
+                ld      (hl),'M'
+                inc     hl
+                ld      b,B_ADDR-B_STATE        ; B_ADDR is set by the caller
+api_start_clear:
+                ld      (hl),0
+                inc     hl
+                djnz    api_start_clear
+                ld      hl,NO_RTT
+                ld      (BLOCK+B_MIN),hl
+                ld      hl,1                    ; first probe with next frame
+r2_15:          ld      (v_timer),hl
+r2_16:          ld      a,(v_state)
+                and     STATE_PAUSED
+                or      STATE_IDLE
+                jr      set_state
+
+api_interval:
+                ld      a,d
+                or      e
+                jr      nz,api_interval_set
+                inc     e
+api_interval_set:
+r3_17:          ld      (v_interval),de
+                and     a
+                ret
+
+api_stop:
+                xor     a
+                jr      set_state
+
+api_pause:                              ; the flag is bit 7 of the state
+r2_18:          ld      hl,v_state
+                ld      a,(hl)
+                or      a
+                ret     z
+                inc     e
+                dec     e
+                jr      z,api_resume
+                cp      STATE_WAIT
+                jr      nz,api_pause_idle
+                ld      hl,(BLOCK+B_SENT)       ; the probe is dropped
+                dec     hl
+                ld      (BLOCK+B_SENT),hl
+api_pause_idle:
+r2_19:          call    set_idle
+                or      STATE_PAUSED
+                jr      api_pause_set
+api_resume:
+                and     $ff-STATE_PAUSED
+api_pause_set:
+r2_20:          jp      set_state
+
+;------------------------------------------------------------------------------
+; parse: parses one byte (A) of the response; CY = response complete,
+; D = RESULT_xxx; E is preserved
+;------------------------------------------------------------------------------
+parse:
+                cp      $0a
+                jr      z,parse_eol
+                ld      c,a
+r2_21:          ld      a,(v_line)
+                or      a
+                jr      z,parse_first
+                cp      LINE_NUMBER
+                jr      nz,parse_none
+                ld      a,c
+                sub     '0'
+                cp      10
+                jr      nc,parse_skip
+r2_22:          ld      hl,(v_rtt)              ; RTT = RTT * 10 + digit
+                ld      b,h
+                ld      c,l
+                add     hl,hl
+                add     hl,hl
+                add     hl,bc
+                add     hl,hl
+                add     hl,a
+r2_23:          ld      (v_rtt),hl
+parse_none:
+                and     a
+                ret
+parse_first:
+                ld      a,c
+                cp      $0d
+                jr      z,parse_none
+                cp      '+'
+                jr      z,parse_plus
+                cp      'O'
+                ld      a,LINE_OK
+                jr      z,parse_kind
+                ld      a,c
+                cp      'E'
+                ld      a,LINE_ERROR
+                jr      z,parse_kind
+                ld      a,c
+                cp      'F'
+                ld      a,LINE_FAIL
+                jr      z,parse_kind
+parse_skip:
+                ld      a,LINE_SKIP
+                jr      parse_kind
+parse_plus:
+                ld      hl,0
+r2_24:          ld      (v_rtt),hl
+                ld      a,LINE_NUMBER
+parse_kind:
+r2_25:          ld      (v_line),a
+                and     a
+                ret
+parse_eol:
+r2_26:          ld      hl,v_line
+                ld      a,(hl)
+                ld      (hl),LINE_START
+                ld      d,RESULT_ERROR
+                cp      LINE_ERROR
+                scf
+                ret     z
+                ld      d,RESULT_TIMEOUT
+                cp      LINE_FAIL
+                scf
+                ret     z
+                cp      LINE_OK
+                jr      nz,parse_none
+r2_27:          ld      hl,(v_rtt)
+                inc     hl
+                ld      a,h
+                or      l
+                scf
+                ret     z                       ; "OK" without "+<rtt>"
+                ld      d,RESULT_OK
+                ret
+
+;==============================================================================
+;                              Variables
+;==============================================================================
+v_state:        defb    STATE_STOPPED           ; + STATE_PAUSED
+v_timer:        defw    0                       ; frames until timeout/probe
+v_interval:     defw    DEFAULT_FRAMES
+v_line:         defb    LINE_START
+v_rtt:          defw    NO_RTT
+v_cmd:          defs    CMD_SIZE                ; AT+PING="a.b.c.d"\r\n
+
+                defs    DRIVER_SIZE-$           ; fails if the code is too big
+
+;==============================================================================
+;                              Relocation table
+;==============================================================================
+reloc_table:
+                defw    r2_01+2
+                defw    r2_02+2
+                defw    r2_03+2
+                defw    r2_04+2
+                defw    r2_05+2
+                defw    r2_06+2
+                defw    r2_07+2
+                defw    r2_08+2
+                defw    r2_09+2
+                defw    r3_10+3
+                defw    r2_11+2
+                defw    r2_12+2
+                defw    r2_13+2
+                defw    r2_14+2
+                defw    r2_15+2
+                defw    r2_16+2
+                defw    r3_17+3
+                defw    r2_18+2
+                defw    r2_19+2
+                defw    r2_20+2
+                defw    r2_21+2
+                defw    r2_22+2
+                defw    r2_23+2
+                defw    r2_24+2
+                defw    r2_25+2
+                defw    r2_26+2
+                defw    r2_27+2
+reloc_end:
+                defs    DRIVER_RELOCS*2-(reloc_end-reloc_table)
+                defs    (reloc_end-reloc_table)-DRIVER_RELOCS*2
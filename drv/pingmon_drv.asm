@@ -0,0 +1,50 @@
+; +------------------------------------------------------------------------------+
+; |                                                                              |
+; | filename: pingmon_drv.asm                                                    |
+; | project:  ZX Spectrum Next - PING                                            |
+; | author:   Stefan Zell                                                        |
+; | date:     16/10/2026                                                         |
+; |                                                                              |
+; +------------------------------------------------------------------------------+
+; |                                                                              |
+; | description:                                                                 |
+; |                                                                              |
+; | .DRV file of the resident monitor                                            |
+; |                                                                              |
+; | Header of NextZXOS followed by the driver code and its relocation table      |
+; | ("pingmon.bin", see "pingmon.asm"). The driver is installed with             |
+; | ".install pingmon.drv" and removed with ".ping -U".                          |
+; |                                                                              |
+; +------------------------------------------------------------------------------+
+; |                                                                              |
+; | Copyright (c) 16/10/2026 STZ Engineering                                     |
+; |                                                                              |
+; | This software is provided  "as is",  without warranty of any kind, express   |
+; | or implied. In no event shall STZ or its contributors be held liable for any |
+; | direct, indirect, incidental, special or consequential damages arising out   |
+; | of the use of or inability to use this software.                             |
+; |                                                                              |
+; | Permission is granted to anyone  to use this  software for any purpose,      |
+; | including commercial applications,  and to alter it and redistribute it      |
+; | freely, subject to the following restrictions:                               |
+; |                                                                              |
+; | 1. Redistributions of source code must retain the above copyright            |
+; |    notice, definition, disclaimer, and this list of conditions.              |
+; |                                                                              |
+; | 2. Redistributions in binary form must reproduce the above copyright         |
+; |    notice, definition, disclaimer, and this list of conditions in            |
+; |    documentation and/or other materials provided with the distribution.      |
+; |                                                                          ;-) |
+; +------------------------------------------------------------------------------+
+
+                include "pingmon.inc"
+
+                org     $0000
+
+                defm    "NDRV"                  ; signature
+                defb    DRIVER_ID+$80           ; bit 7: called on IM1
+                defb    DRIVER_RELOCS
+                defb    0                       ; additional DivMMC pages
+                defb    0                       ; additional ZX pages
+
+                binary  "pingmon.bin"           ; code + relocation table
@@ -0,0 +1,82 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: zxn.h                                                              |
+| project:  ZX Spectrum Next - PING                                            |
+| author:   Stefan Zell                                                        |
+| date:     16/10/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Host shim of the z88dk header <arch/zxn.h>                                   |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 16/10/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+#if !defined(__ARCH_ZXN_H__)
+  #define __ARCH_ZXN_H__
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+CPU speed of the Z80N
+*/
+#define RTM_3MHZ  (0x00)
+#define RTM_7MHZ  (0x01)
+#define RTM_14MHZ (0x02)
+#define RTM_28MHZ (0x03)
+
+/*!
+Attributes of the ULA screen
+*/
+#define INK_BLACK    (0x00)
+#define INK_GREEN    (0x04)
+#define INK_WHITE    (0x07)
+#define PAPER_BLACK  (0x00)
+#define BRIGHT       (0x40)
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+/*!
+Display functions of the ULA screen (z88dk <arch/zx.h>); the host keeps the
+screen in memory (see "zxnsim.c")
+*/
+void zx_cls(unsigned char attr);
+unsigned char* zx_cxy2saddr(unsigned char x, unsigned char y);
+unsigned char* zx_cxy2aaddr(unsigned char x, unsigned char y);
+unsigned char* zx_pxy2saddr(unsigned char x, unsigned char y);
+unsigned char zx_px2bitmask(unsigned char x);
+unsigned char* zx_saddrpdown(void* saddr);
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#endif /* __ARCH_ZXN_H__ */
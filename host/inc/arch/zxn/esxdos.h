@@ -0,0 +1,130 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: esxdos.h                                                           |
+| project:  ZX Spectrum Next - PING                                            |
+| author:   Stefan Zell                                                        |
+| date:     16/10/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Host shim of the z88dk header <arch/zxn/esxdos.h>                            |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 16/10/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+#if !defined(__ARCH_ZXN_ESXDOS_H__)
+  #define __ARCH_ZXN_ESXDOS_H__
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <stddef.h>
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+Version information of NextOS
+*/
+#define ESX_DOSVERSION_NEXTOS_48K      (0x0000)
+#define ESX_DOSVERSION_NEXTOS_MAJOR(v) (((v) >> 8) & 0xFF)
+#define ESX_DOSVERSION_NEXTOS_MINOR(v) ((v) & 0xFF)
+
+/*!
+Modes of "esx_f_open"
+*/
+#define ESX_MODE_READ        (0x01)
+#define ESX_MODE_WRITE       (0x02)
+#define ESX_MODE_OPEN_EXIST  (0x00)
+#define ESX_MODE_OPEN_CREAT  (0x08)
+#define ESX_MODE_CREAT_NOEXIST (0x04)
+#define ESX_MODE_CREAT_TRUNC (0x0C)
+
+/*!
+Origins of "esx_f_seek"
+*/
+#define ESX_SEEK_SET (0x00)
+#define ESX_SEEK_FWD (0x01)
+#define ESX_SEEK_BWD (0x02)
+
+/*!
+Handle returned by "esx_f_open" on errors
+*/
+#define ESX_HANDLE_INVALID (0xFF)
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+/*!
+Date and time in DOS format (see "esx_m_getdate")
+*/
+struct dos_tm
+{
+  uint16_t time;
+  uint16_t date;
+};
+
+/*!
+File information returned by "esx_f_fstat"
+*/
+struct esx_stat
+{
+  uint8_t  drive;
+  uint8_t  device;
+  uint8_t  attr;
+  uint32_t date;
+  uint32_t size;
+};
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+/*!
+Read the version of NextOS
+*/
+uint16_t esx_m_dosversion(void);
+
+/*!
+Read date and time of the RTC
+@return 0 = OK; otherwise no RTC available
+*/
+unsigned char esx_m_getdate(struct dos_tm* tm);
+
+/*!
+File access of esxDOS (mapped to the file system of the host); on errors
+"errno" is set
+*/
+unsigned char esx_f_open(char* filename, unsigned char mode);
+unsigned char esx_f_close(unsigned char handle);
+uint16_t esx_f_read(unsigned char handle, void* dst, size_t len);
+uint16_t esx_f_write(unsigned char handle, void* src, size_t len);
+uint32_t esx_f_seek(unsigned char handle, uint32_t distance, unsigned char whence);
+unsigned char esx_f_fstat(unsigned char handle, struct esx_stat* es);
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#endif /* __ARCH_ZXN_ESXDOS_H__ */
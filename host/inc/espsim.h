@@ -0,0 +1,339 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: espsim.h                                                           |
+| project:  ZX Spectrum Next - PING                                            |
+| author:   Stefan Zell                                                        |
+| date:     16/10/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Scripted stand-in for the ESP8266 (host build only)                          |
+|                                                                              |
+| The simulator is configured by environment variables:                        |
+|  ESPSIM_RTT      round trip time of a successful ping [ms]                   |
+|  ESPSIM_JITTER   maximum deviation of the round trip time [ms]               |
+|  ESPSIM_LOSS     percentage of pings answered with a timeout                 |
+|  ESPSIM_ERROR    percentage of pings answered with ERROR                     |
+|  ESPSIM_BUSY     percentage of pings answered with "busy p..."               |
+|  ESPSIM_DUP      percentage of UDP echo replies received twice               |
+|  ESPSIM_REFUSED  TCP port without listener (connect refused after the RTT)   |
+|  ESPSIM_WIFI     throughput of the TCP connection to the sink [kbit/s]       |
+|  ESPSIM_NOISE    length of an unsolicited line sent before each response     |
+|  ESPSIM_DNS      time to resolve a hostname [ms]; added to every ping of a   |
+|                  hostname (not of an IP address)                             |
+|  ESPSIM_MAXBAUD  highest baudrate the Next receives without errors [bit/s]   |
+|  ESPSIM_SEED     seed of the random generator                                |
+|  ESPSIM_BREAK    simulate user break after x pings                           |
+|  ESPSIM_REALTIME really wait for simulated delays, if set to "1"             |
+|  ESPSIM_TRACE    print all AT commands to stderr, if set to "1"              |
+|  ESPSIM_REPLAY   capture file ("-C") that is replayed instead of the script  |
+|  ESPSIM_SPEED    replay: time factor (1 = original timing, 0 = no delays)    |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 16/10/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+#if !defined(__ESPSIM_H__)
+  #define __ESPSIM_H__
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+Maximum number of lines pending in the receive queue of the simulator
+*/
+#define uiESPSIM_QUEUE (0x20)
+
+/*!
+Maximum length of a simulated response line
+*/
+#define uiESPSIM_LINE (0x200)
+
+/*!
+Baudrate of the ESP8266 after reset [bit/s]
+*/
+#define uiESPSIM_BAUD (115200UL)
+
+/*!
+Time to transfer one byte (10 bits) over the UART [ns]
+*/
+#define ESPSIM_BYTE_TIME(baud) (10000000000ULL / (baud))
+
+/*!
+Time the ESP8266 needs to signal a timeout of "AT+PING" [ms]
+*/
+#define uiESPSIM_PING_TIMEOUT (1000)
+
+/*!
+Time the ESP8266 waits for the handshake of "AT+CIPSTART" [ms]
+*/
+#define uiESPSIM_CONNECT_TIMEOUT (5000)
+
+/*!
+Maximum number of bytes of one "AT+CIPSEND" in single-connection mode
+*/
+#define uiESPSIM_MAX_SEND (2048)
+
+/*!
+Silence the ESP8266 needs before "+++" to leave the passthrough mode [ms]
+*/
+#define uiESPSIM_ESCAPE_GAP (20)
+
+/*!
+Time "esp_receive_ex" waits for a line before giving up [ms]
+*/
+#define uiESPSIM_RX_TIMEOUT (2000)
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+/*!
+Line that is pending in the receive queue of the simulator
+*/
+typedef struct _espsim_line
+{
+  /*!
+  Simulated time the ESP8266 sends the line [us]; the lines are sorted by it
+  */
+  uint64_t uiReady;
+
+  /*!
+  Simulated time the line is completely received [us]
+  */
+  uint64_t uiDue;
+
+  /*!
+  Baudrate the line is sent with [bit/s]
+  */
+  uint32_t uiBaud;
+
+  /*!
+  Content of the line (including CR/LF)
+  */
+  char acText[uiESPSIM_LINE];
+} espsim_line_t;
+
+/*!
+State of the simulator
+*/
+typedef struct _espsim
+{
+  /*!
+  If this flag is set, then this structure is initialized
+  */
+  bool bInitialized;
+
+  /*!
+  Configuration (see description of this file)
+  */
+  uint16_t uiRtt;
+  uint16_t uiJitter;
+  uint8_t  uiLoss;
+  uint8_t  uiError;
+  uint8_t  uiBusy;
+  uint8_t  uiDup;
+  uint16_t uiRefused;
+  uint32_t uiWifi;
+  uint16_t uiNoise;
+  uint16_t uiDns;
+  uint32_t uiMaxBaud;
+  uint32_t uiBreak;
+  bool     bRealtime;
+  bool     bTrace;
+  uint32_t uiSpeed;
+
+  /*!
+  Content of the capture file that is replayed ("ESPSIM_REPLAY"); 0 if the
+  responses are created by the script
+  */
+  uint8_t* auiReplay;
+  size_t   uiReplaySize;
+
+  /*!
+  Offsets of the commands (records sent by the application) in the capture
+  file; the replies to a command are the received records up to the next
+  command
+  */
+  size_t* auiCommand;
+  size_t  uiCommands;
+
+  /*!
+  Index of the command of the capture that is expected next
+  */
+  size_t uiNextCommand;
+
+  /*!
+  State of the random generator
+  */
+  uint32_t uiRandom;
+
+  /*!
+  Baudrates of the ESP8266 ("AT+UART_CUR") and of the Next ("espbaud_set");
+  if they differ, both sides receive garbage only [bit/s]
+  */
+  uint32_t uiEspBaud;
+  uint32_t uiNextBaud;
+
+  /*!
+  Simulated time since start [us]
+  */
+  uint64_t uiClock;
+
+  /*!
+  Connections of the multi-connection mode ("AT+CIPSTART", bit = link)
+  */
+  uint8_t uiLinks;
+
+  /*!
+  If this flag is set, the TCP connection of single-connection mode is open
+  */
+  bool bConnected;
+
+  /*!
+  Connection of the pending "AT+CIPSEND" (-1 = none); the next bytes sent by
+  the application are the data of the connection
+  */
+  int8_t iSendLink;
+
+  /*!
+  Remaining bytes of the pending "AT+CIPSEND=<length>" of single-connection
+  mode and the length of the command
+  */
+  uint16_t uiSendLeft;
+  uint16_t uiSendLen;
+
+  /*!
+  Transmit mode "AT+CIPMODE" and state of the passthrough: if "bStreaming"
+  is set, all bytes sent by the application go to the TCP sink until "+++"
+  */
+  bool bPassthrough;
+  bool bStreaming;
+
+  /*!
+  Simulated time the last byte was sent by the application [us]
+  */
+  uint64_t uiLastTx;
+
+  /*!
+  Number of bytes received by the TCP sink
+  */
+  uint64_t uiSunk;
+
+  /*!
+  Number of "AT+PING" commands and UDP echo probes received
+  */
+  uint32_t uiPings;
+
+  /*!
+  Number of hostnames resolved (by "AT+CIPDOMAIN" or "AT+PING")
+  */
+  uint32_t uiLookups;
+
+  /*!
+  Receive queue
+  */
+  espsim_line_t atQueue[uiESPSIM_QUEUE];
+  uint8_t uiHead;
+  uint8_t uiTail;
+
+  /*!
+  Number of bytes of the first line in the queue that are already read
+  */
+  uint16_t uiPos;
+} espsim_t;
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+/*!
+Returns the state of the simulator; the configuration is read from the
+environment on first use.
+*/
+espsim_t* espsim_get(void);
+
+/*!
+Advance the simulated time by the given duration
+@param uiMicros Duration [us]
+*/
+void espsim_advance(uint64_t uiMicros);
+
+/*!
+Read the next byte of the receive queue, if it is completely received
+@return Received byte; negative, if the queue is empty or the next byte is
+        not yet received
+*/
+int espsim_getc(void);
+
+/*!
+Advance the simulated time until the next byte of the receive queue is
+received, but at most by the given duration (polling of the UART)
+@param uiMicros Maximum duration [us]
+*/
+void espsim_poll(uint64_t uiMicros);
+
+/*!
+Discard all lines pending in the receive queue
+*/
+void espsim_flush(void);
+
+/*!
+Returns the next value of the (deterministic) random generator
+*/
+uint32_t espsim_random(void);
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#endif /* __ESPSIM_H__ */
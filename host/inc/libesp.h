@@ -0,0 +1,130 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: libesp.h                                                           |
+| project:  ZX Spectrum Next - PING                                            |
+| author:   Stefan Zell                                                        |
+| date:     16/10/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Host shim of "libesp" for the native build against the ESP simulator         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 16/10/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+#if !defined(__LIBESP_H__)
+  #define __LIBESP_H__
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <stddef.h>
+
+#include "libzxn.h"
+#include "libuart.h"
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+Classification of a line received from the ESP8266 (see "esp_receive_ex")
+*/
+#define ESP_LINE_DATA    (0x00)
+#define ESP_LINE_OK      (0x01)
+#define ESP_LINE_ERROR   (0x02)
+#define ESP_LINE_FAIL    (0x03)
+#define ESP_LINE_TIMEOUT (0x04)
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+/*!
+Device data of an ESP connection
+*/
+typedef struct _esp
+{
+  /*!
+  UART the ESP8266 is connected to
+  */
+  uart_t tUart;
+} esp_t;
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+/*!
+Open the connection to the ESP8266
+*/
+int esp_open(esp_t* pEsp);
+
+/*!
+Close the connection to the ESP8266
+*/
+int esp_close(esp_t* pEsp);
+
+/*!
+Discard all pending data of the ESP8266
+*/
+int esp_flush(esp_t* pEsp);
+
+/*!
+Send a command to the ESP8266
+*/
+int esp_transmit(esp_t* pEsp, const char_t* acCmd);
+
+/*!
+Read the next line from the ESP8266 and classify it (ESP_LINE_xxx)
+*/
+uint8_t esp_receive_ex(esp_t* pEsp, char_t* acBuffer, size_t uiSize);
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#endif /* __LIBESP_H__ */
@@ -0,0 +1,144 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: libzxn.h                                                           |
+| project:  ZX Spectrum Next - PING                                            |
+| author:   Stefan Zell                                                        |
+| date:     16/10/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Host shim of "libzxn" for the native build against the ESP simulator         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 16/10/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+#if !defined(__LIBZXN_H__)
+  #define __LIBZXN_H__
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <errno.h>
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+Errorcodes of "libzxn" that are unknown to the host C library
+*/
+#if !defined(EOK)
+  #define EOK (0)
+#endif
+
+#if !defined(EBREAK)
+  #define EBREAK (0x7E)
+#endif
+
+#if !defined(ETIMEOUT)
+  #define ETIMEOUT (0x7D)
+#endif
+
+/*!
+Debug output (only in debug builds)
+*/
+#if defined(__DEBUG__)
+  #define DBGPRINTF(...) fprintf(stderr, __VA_ARGS__)
+#else
+  #define DBGPRINTF(...)
+#endif
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+/*!
+Character type used by all ZXN libraries
+*/
+typedef char char_t;
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+/*!
+Read the current speed of the Z80N (RTM_xMHZ)
+*/
+uint8_t zxn_getspeed(void);
+
+/*!
+Set the speed of the Z80N (RTM_xMHZ)
+*/
+void zxn_setspeed(uint8_t uiSpeed);
+
+/*!
+Delay execution for the given time in [ms]
+*/
+void zxn_sleep_ms(uint16_t uiTime);
+
+/*!
+Remove trailing whitespaces from the given string
+*/
+char_t* zxn_rtrim(char_t* acString);
+
+/*!
+Convert an errorcode into the value that is handed over to BASIC
+*/
+int zxn_strerror(int iCode);
+
+/*!
+String functions of z88dk that are not part of the host C library
+*/
+int stricmp(const char* s1, const char* s2);
+char* strupr(char* s);
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#endif /* __LIBZXN_H__ */
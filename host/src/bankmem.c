@@ -0,0 +1,190 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: bankmem.c                                                          |
+| project:  ZX Spectrum Next - PING                                            |
+| author:   Stefan Zell                                                        |
+| date:     16/10/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Host replacement of "bankmem.c"; the pages are static memory of the host     |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 16/10/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <errno.h>
+
+#include "libzxn.h"
+#include "bankmem.h"
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+/*!
+Pages of the arena
+*/
+static uint8_t g_auiPage[uiBANKMEM_PAGES][uiBANKMEM_PAGE_SIZE];
+
+/*!
+State of the arena (see "src/bankmem.c")
+*/
+static struct
+{
+  uint8_t  uiPages;
+  uint16_t uiResident;
+  uint16_t uiFar;
+} g_tArena;
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/* bankmem_init()                                                             */
+/*----------------------------------------------------------------------------*/
+int bankmem_init(void)
+{
+  if (0 == g_tArena.uiPages)
+  {
+    g_tArena.uiPages    = 1;
+    g_tArena.uiResident = 0;
+    g_tArena.uiFar      = uiBANKMEM_PAGE_SIZE;
+  }
+
+  return EOK;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* bankmem_exit()                                                             */
+/*----------------------------------------------------------------------------*/
+void bankmem_exit(void)
+{
+  g_tArena.uiPages = 0;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* bankmem_alloc()                                                            */
+/*----------------------------------------------------------------------------*/
+void* bankmem_alloc(uint16_t uiSize)
+{
+  void* pReturn = 0;
+
+  uiSize = (uiSize + 1) & ~1;
+
+  if ((0 != g_tArena.uiPages) && (uiSize <= (uiBANKMEM_PAGE_SIZE - g_tArena.uiResident)))
+  {
+    pReturn = &g_auiPage[0][g_tArena.uiResident];
+    g_tArena.uiResident += uiSize;
+  }
+
+  return pReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* bankmem_falloc()                                                           */
+/*----------------------------------------------------------------------------*/
+bankmem_t bankmem_falloc(uint16_t uiSize)
+{
+  bankmem_t tReturn;
+
+  uiSize = (uiSize + 1) & ~1;
+
+  if ((0 == g_tArena.uiPages) || (0 == uiSize) || (uiBANKMEM_PAGE_SIZE < uiSize))
+  {
+    return uiBANKMEM_NULL;
+  }
+
+  if (uiSize > (uiBANKMEM_PAGE_SIZE - g_tArena.uiFar))
+  {
+    if (uiBANKMEM_PAGES <= g_tArena.uiPages)
+    {
+      return uiBANKMEM_NULL;
+    }
+
+    ++g_tArena.uiPages;
+    g_tArena.uiFar = 0;
+  }
+
+  tReturn = (bankmem_t) ((((bankmem_t) (g_tArena.uiPages - 1)) << 13) | g_tArena.uiFar);
+  g_tArena.uiFar += uiSize;
+
+  return tReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* bankmem_map()                                                              */
+/*----------------------------------------------------------------------------*/
+void* bankmem_map(bankmem_t tAddr)
+{
+  return &g_auiPage[tAddr >> 13][tAddr & (uiBANKMEM_PAGE_SIZE - 1)];
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* bankmem_unmap()                                                            */
+/*----------------------------------------------------------------------------*/
+void bankmem_unmap(void)
+{
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
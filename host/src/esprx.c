@@ -0,0 +1,142 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: esprx.c                                                            |
+| project:  ZX Spectrum Next - PING                                            |
+| author:   Stefan Zell                                                        |
+| date:     16/10/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Receive path of the ESP8266 stand-in (host build only)                       |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 16/10/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "esprx.h"
+#include "espsim.h"
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+Maximum simulated time that passes while polling an idle UART [us]
+*/
+#define uiESPRX_POLL_US (1000)
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+/*!
+Statistical information (the stand-in has no ring buffer)
+*/
+static esprx_stats_t g_tStats;
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/* esprx_init()                                                               */
+/*----------------------------------------------------------------------------*/
+void esprx_init(void)
+{
+  espsim_get();
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* esprx_exit()                                                               */
+/*----------------------------------------------------------------------------*/
+void esprx_exit(void)
+{
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* esprx_flush()                                                              */
+/*----------------------------------------------------------------------------*/
+void esprx_flush(void)
+{
+  espsim_flush();
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* esprx_getc()                                                               */
+/*----------------------------------------------------------------------------*/
+int esprx_getc(void)
+{
+  int iByte = espsim_getc();
+
+  if (0 > iByte)
+  {
+    espsim_poll(uiESPRX_POLL_US);
+  }
+
+  return iByte;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* esprx_stats()                                                              */
+/*----------------------------------------------------------------------------*/
+const esprx_stats_t* esprx_stats(void)
+{
+  return &g_tStats;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
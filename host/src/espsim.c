@@ -0,0 +1,1121 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: espsim.c                                                           |
+| project:  ZX Spectrum Next - PING                                            |
+| author:   Stefan Zell                                                        |
+| date:     16/10/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Scripted stand-in for the ESP8266 (host build only)                          |
+| Implements the interface of "libesp" and answers AT+PING, AT+CIPDOMAIN,      |
+| AT+UART_CUR, AT+GMR and AT+CIPSTA_CUR? with configurable latency, loss and   |
+| error lines, or replays a capture of a real session ("-C"). In multi-        |
+| connection mode the UDP connections are answered by an echo service, in     |
+| single-connection mode "AT+CIPSTART" connects to a TCP listener that sinks  |
+| the data of "AT+CIPSEND" or of the passthrough mode.                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 16/10/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "libzxn.h"
+#include "libesp.h"
+#include "espcap.h"
+#include "espsim.h"
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+/*!
+State of the simulator
+*/
+static espsim_t g_tSim;
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+/*!
+Read a numerical configuration value from the environment
+*/
+static uint32_t espsim_getenv(const char* acName, uint32_t uiDefault);
+
+/*!
+Append a line to the receive queue
+@param uiDelay Delay relative to the current simulated time [us]
+@param acText Content of the line (without CR/LF)
+*/
+static void espsim_queue(uint64_t uiDelay, const char* acText);
+
+/*!
+Add received bytes to the receive queue as they are (without CR/LF). The
+lines are sorted by the time they are sent by the ESP8266, so a response may
+overtake a reply of the network that is still on its way.
+@param uiDelay Delay relative to the current simulated time [us]
+@param acText Received bytes
+*/
+static void espsim_queue_raw(uint64_t uiDelay, const char* acText);
+
+/*!
+Read the capture file given by "ESPSIM_REPLAY" and index its commands
+*/
+static void espsim_load(const char* acFile);
+
+/*!
+Replay the response to a command: the bytes received after the next equal
+command of the capture file are queued with their original delays (divided
+by "ESPSIM_SPEED"); a command that is not in the rest of the capture is not
+answered
+@param acCmd Command sent by the application
+*/
+static void espsim_replay(const char* acCmd);
+
+/*!
+Resolve a hostname like a DNS server would do; names containing "invalid"
+are unknown. The simulated time is advanced by "ESPSIM_DNS".
+@param acName Hostname or IP address (terminated by '"')
+@param acAddr Buffer for the IP address (16 bytes)
+@return "true" if the name is known
+*/
+static bool espsim_resolve(const char* acName, char* acAddr);
+
+/*!
+Create the response to an "AT+PING" command
+@param acHost Argument of the command
+*/
+static void espsim_ping(const char* acHost);
+
+/*!
+Create the response to an "AT+CIPDOMAIN" command
+@param acHost Argument of the command
+*/
+static void espsim_domain(const char* acHost);
+
+/*!
+Create the response to "AT+CIPSTART=<link>,"UDP",..." (echo service)
+@param acArgs Arguments of the command
+*/
+static void espsim_cipstart(const char* acArgs);
+
+/*!
+Create the response to "AT+CIPSTART="TCP",..." of single-connection mode:
+the handshake takes one round trip time
+@param acArgs Arguments of the command
+*/
+static void espsim_connect(const char* acArgs);
+
+/*!
+Create the response to the data of "AT+CIPSEND": the echo service replies
+by "+IPD" after the round trip time
+@param acData Data sent by the application
+*/
+static void espsim_echo(const char* acData);
+
+/*!
+Pass the data of "AT+CIPSEND=<length>" to the TCP sink; "SEND OK" follows
+when the last byte is transferred over WiFi ("ESPSIM_WIFI") and
+acknowledged by the sink (one round trip time)
+@param acData Data sent by the application
+*/
+static void espsim_sink(const char* acData);
+
+/*!
+Time the next byte of the receive queue is completely received [us] (the
+queue must not be empty)
+*/
+static uint64_t espsim_due(void);
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/* espsim_getenv()                                                            */
+/*----------------------------------------------------------------------------*/
+static uint32_t espsim_getenv(const char* acName, uint32_t uiDefault)
+{
+  const char* acValue = getenv(acName);
+
+  return (acValue && *acValue ? (uint32_t) strtoul(acValue, 0, 0) : uiDefault);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* espsim_get()                                                               */
+/*----------------------------------------------------------------------------*/
+espsim_t* espsim_get(void)
+{
+  if (!g_tSim.bInitialized)
+  {
+    g_tSim.uiRtt     = (uint16_t) espsim_getenv("ESPSIM_RTT", 20);
+    g_tSim.uiJitter  = (uint16_t) espsim_getenv("ESPSIM_JITTER", 0);
+    g_tSim.uiLoss    = (uint8_t)  espsim_getenv("ESPSIM_LOSS", 0);
+    g_tSim.uiError   = (uint8_t)  espsim_getenv("ESPSIM_ERROR", 0);
+    g_tSim.uiBusy    = (uint8_t)  espsim_getenv("ESPSIM_BUSY", 0);
+    g_tSim.uiDup     = (uint8_t)  espsim_getenv("ESPSIM_DUP", 0);
+    g_tSim.uiRefused = (uint16_t) espsim_getenv("ESPSIM_REFUSED", 0);
+    g_tSim.uiWifi    = espsim_getenv("ESPSIM_WIFI", 4000);
+    g_tSim.uiNoise   = (uint16_t) espsim_getenv("ESPSIM_NOISE", 0);
+    g_tSim.uiDns     = (uint16_t) espsim_getenv("ESPSIM_DNS", 50);
+    g_tSim.uiMaxBaud = espsim_getenv("ESPSIM_MAXBAUD", 2000000);
+    g_tSim.uiEspBaud = uiESPSIM_BAUD;
+    g_tSim.uiNextBaud = uiESPSIM_BAUD;
+    g_tSim.uiBreak   = espsim_getenv("ESPSIM_BREAK", 0);
+    g_tSim.bRealtime = (0 != espsim_getenv("ESPSIM_REALTIME", 0));
+    g_tSim.bTrace    = (0 != espsim_getenv("ESPSIM_TRACE", 0));
+    g_tSim.uiRandom  = espsim_getenv("ESPSIM_SEED", 0x2545F491);
+    g_tSim.uiSpeed   = espsim_getenv("ESPSIM_SPEED", 1);
+    g_tSim.uiClock   = 0;
+    g_tSim.uiPings   = 0;
+    g_tSim.uiLinks   = 0;
+    g_tSim.bConnected = false;
+    g_tSim.iSendLink = -1;
+    g_tSim.uiSendLeft = 0;
+    g_tSim.bPassthrough = false;
+    g_tSim.bStreaming = false;
+    g_tSim.uiLastTx  = 0;
+    g_tSim.uiSunk    = 0;
+    g_tSim.uiHead    = 0;
+    g_tSim.uiTail    = 0;
+    g_tSim.uiPos     = 0;
+
+    if (0 == g_tSim.uiRandom)
+    {
+      g_tSim.uiRandom = 1;
+    }
+
+    g_tSim.bInitialized = true;
+
+    if (getenv("ESPSIM_REPLAY"))
+    {
+      espsim_load(getenv("ESPSIM_REPLAY"));
+    }
+  }
+
+  return &g_tSim;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* espsim_advance()                                                           */
+/*----------------------------------------------------------------------------*/
+void espsim_advance(uint64_t uiMicros)
+{
+  g_tSim.uiClock += uiMicros;
+
+  if (g_tSim.bRealtime && (0 != uiMicros))
+  {
+    struct timespec tDelay;
+    tDelay.tv_sec  = (time_t) (uiMicros / 1000000);
+    tDelay.tv_nsec = (long) ((uiMicros % 1000000) * 1000);
+    nanosleep(&tDelay, 0);
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* espsim_random()                                                            */
+/*----------------------------------------------------------------------------*/
+uint32_t espsim_random(void)
+{
+  /* xorshift32 */
+  g_tSim.uiRandom ^= g_tSim.uiRandom << 13;
+  g_tSim.uiRandom ^= g_tSim.uiRandom >> 17;
+  g_tSim.uiRandom ^= g_tSim.uiRandom << 5;
+
+  return g_tSim.uiRandom;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* espsim_queue()                                                             */
+/*----------------------------------------------------------------------------*/
+static void espsim_queue(uint64_t uiDelay, const char* acText)
+{
+  char acLine[uiESPSIM_LINE + 2];
+
+  snprintf(acLine, sizeof(acLine), "%s\r\n", acText);
+
+  espsim_queue_raw(uiDelay, acLine);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* espsim_queue_raw()                                                         */
+/*----------------------------------------------------------------------------*/
+static void espsim_queue_raw(uint64_t uiDelay, const char* acText)
+{
+  uint64_t uiByte  = ESPSIM_BYTE_TIME(g_tSim.uiEspBaud);
+  uint64_t uiStart = g_tSim.uiClock + uiDelay;
+  uint64_t uiDue;
+  uint8_t uiCount = (uint8_t) ((g_tSim.uiTail + uiESPSIM_QUEUE - g_tSim.uiHead) % uiESPSIM_QUEUE);
+  uint8_t uiPos   = uiCount;
+  uint8_t i;
+
+  if ((uiCount + 1) >= uiESPSIM_QUEUE)
+  {
+    return;
+  }
+
+  /* Before the first line that starts later; a line that is partly read
+     stays the first one */
+  while (uiPos > (0 != g_tSim.uiPos ? 1 : 0))
+  {
+    const espsim_line_t* pLine = &g_tSim.atQueue[(g_tSim.uiHead + uiPos - 1) % uiESPSIM_QUEUE];
+
+    if (pLine->uiReady <= uiStart)
+    {
+      break;
+    }
+
+    --uiPos;
+  }
+
+  for (i = uiCount; i > uiPos; --i)
+  {
+    g_tSim.atQueue[(g_tSim.uiHead + i) % uiESPSIM_QUEUE] = g_tSim.atQueue[(g_tSim.uiHead + i - 1) % uiESPSIM_QUEUE];
+  }
+
+  g_tSim.uiTail = (uint8_t) ((g_tSim.uiTail + 1) % uiESPSIM_QUEUE);
+
+  /* Lines are received one after the other: the following lines are delayed */
+  for (i = uiPos; i <= uiCount; ++i)
+  {
+    espsim_line_t* pLine = &g_tSim.atQueue[(g_tSim.uiHead + i) % uiESPSIM_QUEUE];
+
+    if (i == uiPos)
+    {
+      if (0 != i)
+      {
+        uiDue   = g_tSim.atQueue[(g_tSim.uiHead + i - 1) % uiESPSIM_QUEUE].uiDue;
+        uiStart = (uiDue > uiStart ? uiDue : uiStart);
+      }
+
+      snprintf(pLine->acText, sizeof(pLine->acText), "%s", acText);
+      pLine->uiBaud  = g_tSim.uiEspBaud;
+      pLine->uiReady = g_tSim.uiClock + uiDelay;
+      pLine->uiDue   = uiStart + (strlen(pLine->acText) * uiByte) / 1000;
+    }
+    else
+    {
+      uiDue = g_tSim.atQueue[(g_tSim.uiHead + i - 1) % uiESPSIM_QUEUE].uiDue + (strlen(pLine->acText) * ESPSIM_BYTE_TIME(pLine->uiBaud)) / 1000;
+      pLine->uiDue = (uiDue > pLine->uiDue ? uiDue : pLine->uiDue);
+    }
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* espsim_load()                                                              */
+/*----------------------------------------------------------------------------*/
+static void espsim_load(const char* acFile)
+{
+  FILE* pFile = fopen(acFile, "rb");
+  size_t uiPos = 0;
+  size_t uiLen;
+  long iSize;
+
+  if (!pFile)
+  {
+    fprintf(stderr, "espsim: unable to open \"%s\"\n", acFile);
+    exit(EXIT_FAILURE);
+  }
+
+  fseek(pFile, 0, SEEK_END);
+  iSize = ftell(pFile);
+  fseek(pFile, 0, SEEK_SET);
+
+  g_tSim.auiReplay    = malloc(iSize > 0 ? (size_t) iSize : 1);
+  g_tSim.uiReplaySize = (iSize > 0 ? fread(g_tSim.auiReplay, 1, (size_t) iSize, pFile) : 0);
+
+  fclose(pFile);
+
+  /* Index of the commands; each command is one record */
+  g_tSim.auiCommand    = malloc((g_tSim.uiReplaySize / uiESPCAP_HEADER_SIZE + 1) * sizeof(size_t));
+  g_tSim.uiCommands    = 0;
+  g_tSim.uiNextCommand = 0;
+
+  while ((uiPos + uiESPCAP_HEADER_SIZE) <= g_tSim.uiReplaySize)
+  {
+    uiLen = g_tSim.auiReplay[uiPos + 5];
+
+    if ((uiPos + uiESPCAP_HEADER_SIZE + uiLen) > g_tSim.uiReplaySize)
+    {
+      break;
+    }
+
+    if (uiESPCAP_DIR_TX == g_tSim.auiReplay[uiPos + 4])
+    {
+      g_tSim.auiCommand[g_tSim.uiCommands++] = uiPos;
+    }
+
+    uiPos += uiESPCAP_HEADER_SIZE + uiLen;
+  }
+
+  /* The end of the last reply */
+  g_tSim.uiReplaySize = uiPos;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* espsim_replay()                                                            */
+/*----------------------------------------------------------------------------*/
+static void espsim_replay(const char* acCmd)
+{
+  char acData[0x100];
+  const uint8_t* pRecord;
+  uint32_t uiTime;
+  uint32_t uiSent;
+  size_t uiCmdLen = strlen(acCmd);
+  size_t uiPos;
+  size_t uiEnd;
+  size_t uiLen;
+  size_t i;
+
+  /* The ESP8266 of the capture follows every baudrate of the Next */
+  g_tSim.uiEspBaud = g_tSim.uiNextBaud;
+
+  if (0 == strncmp(acCmd, "AT+PING=", 8))
+  {
+    ++g_tSim.uiPings;
+  }
+
+  /* The reply belongs to the command: commands of the capture that this run
+     does not send (e.g. because of another state of the DNS cache) are
+     skipped */
+  for (i = g_tSim.uiNextCommand; i < g_tSim.uiCommands; ++i)
+  {
+    pRecord = &g_tSim.auiReplay[g_tSim.auiCommand[i]];
+
+    if ((pRecord[5] == uiCmdLen) && (0 == memcmp(pRecord + uiESPCAP_HEADER_SIZE, acCmd, uiCmdLen)))
+    {
+      break;
+    }
+  }
+
+  if (i >= g_tSim.uiCommands)
+  {
+    /* No response: the application sees a timeout */
+    fprintf(stderr, "espsim: not in capture: %s%s", acCmd, (uiCmdLen && ('\n' == acCmd[uiCmdLen - 1]) ? "" : "\n"));
+    return;
+  }
+
+  if (g_tSim.bTrace && (i != g_tSim.uiNextCommand))
+  {
+    fprintf(stderr, "espsim! %u commands of the capture skipped\n", (unsigned) (i - g_tSim.uiNextCommand));
+  }
+
+  g_tSim.uiNextCommand = i + 1;
+
+  pRecord = &g_tSim.auiReplay[g_tSim.auiCommand[i]];
+  uiSent  = pRecord[0] | (pRecord[1] << 8) | (pRecord[2] << 16) | ((uint32_t) pRecord[3] << 24);
+  uiPos   = g_tSim.auiCommand[i] + uiESPCAP_HEADER_SIZE + uiCmdLen;
+  uiEnd   = (g_tSim.uiNextCommand < g_tSim.uiCommands ? g_tSim.auiCommand[g_tSim.uiNextCommand] : g_tSim.uiReplaySize);
+
+  while (uiPos < uiEnd)
+  {
+    pRecord = &g_tSim.auiReplay[uiPos];
+    uiLen   = pRecord[5];
+    uiTime  = pRecord[0] | (pRecord[1] << 8) | (pRecord[2] << 16) | ((uint32_t) pRecord[3] << 24);
+
+    memcpy(acData, pRecord + uiESPCAP_HEADER_SIZE, uiLen);
+    acData[uiLen] = '\0';
+
+    uint64_t uiDelay = ((uiTime - uiSent) * 100ULL) / (0 != g_tSim.uiSpeed ? g_tSim.uiSpeed : UINT32_MAX);
+    uint64_t uiWire  = ((uiCmdLen + uiLen) * ESPSIM_BYTE_TIME(g_tSim.uiEspBaud)) / 1000;
+
+    /* The time of the capture includes the transfer of the command and of
+       the received bytes over the UART */
+    espsim_queue_raw((uiDelay > uiWire ? uiDelay - uiWire : 0), acData);
+
+    uiPos += uiESPCAP_HEADER_SIZE + uiLen;
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* espsim_resolve()                                                           */
+/*----------------------------------------------------------------------------*/
+static bool espsim_resolve(const char* acName, char* acAddr)
+{
+  size_t uiLen = strcspn(acName, "\"");
+  uint32_t uiHash = 2166136261U; /* FNV-1a */
+
+  if (uiLen == strspn(acName, "0123456789."))
+  {
+    snprintf(acAddr, 16, "%.*s", (int) uiLen, acName);
+    return true;
+  }
+
+  ++g_tSim.uiLookups;
+  espsim_advance(g_tSim.uiDns * 1000ULL);
+
+  for (size_t i = 0; i < uiLen; ++i)
+  {
+    uiHash = (uiHash ^ (uint8_t) acName[i]) * 16777619U;
+  }
+
+  snprintf(acAddr, 16, "10.%u.%u.%u", (uiHash >> 16) & 0xFF, (uiHash >> 8) & 0xFF, (uiHash & 0xFE) + 1);
+
+  const char* pUnknown = strstr(acName, "invalid");
+
+  return ((0 == pUnknown) || (pUnknown >= (acName + uiLen)));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* espsim_domain()                                                            */
+/*----------------------------------------------------------------------------*/
+static void espsim_domain(const char* acHost)
+{
+  char acAddr[16];
+  char acLine[32];
+
+  if (espsim_resolve(acHost, acAddr))
+  {
+    snprintf(acLine, sizeof(acLine), "+CIPDOMAIN:%s", acAddr);
+    espsim_queue(0, acLine);
+    espsim_queue(0, "");
+    espsim_queue(0, "OK");
+  }
+  else
+  {
+    espsim_queue(0, "DNS Fail");
+    espsim_queue(0, "ERROR");
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* espsim_ping()                                                              */
+/*----------------------------------------------------------------------------*/
+static void espsim_ping(const char* acHost)
+{
+  char acLine[uiESPSIM_LINE];
+
+  ++g_tSim.uiPings;
+
+  /* The ESP8266 resolves hostnames before each ping */
+  if (!espsim_resolve(acHost, acLine))
+  {
+    espsim_queue(0, "ERROR");
+    return;
+  }
+
+  if (0 != g_tSim.uiNoise)
+  {
+    size_t uiLen = (g_tSim.uiNoise < (sizeof(acLine) - 2) ? g_tSim.uiNoise : (sizeof(acLine) - 3));
+    memset(acLine, 'x', uiLen);
+    acLine[uiLen] = '\0';
+    espsim_queue(0, acLine);
+  }
+
+  if ((espsim_random() % 100) < g_tSim.uiBusy)
+  {
+    /* Command is dropped; the previous command completes later */
+    espsim_queue(0, "busy p...");
+    espsim_queue(g_tSim.uiRtt * 1000ULL, "OK");
+  }
+  else if ((espsim_random() % 100) < g_tSim.uiError)
+  {
+    espsim_queue(0, "ERROR");
+  }
+  else if ((espsim_random() % 100) < g_tSim.uiLoss)
+  {
+    espsim_queue(uiESPSIM_PING_TIMEOUT * 1000ULL, "+timeout");
+    espsim_queue(uiESPSIM_PING_TIMEOUT * 1000ULL, "FAIL");
+  }
+  else
+  {
+    int32_t iTime = g_tSim.uiRtt;
+
+    if (0 != g_tSim.uiJitter)
+    {
+      iTime += (int32_t) (espsim_random() % (2U * g_tSim.uiJitter + 1U)) - g_tSim.uiJitter;
+      iTime  = (iTime < 0 ? 0 : iTime);
+    }
+
+    snprintf(acLine, sizeof(acLine), "+%ld", (long) iTime);
+    espsim_queue(iTime * 1000ULL, acLine);
+    espsim_queue(iTime * 1000ULL, "");
+    espsim_queue(iTime * 1000ULL, "OK");
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* espsim_cipstart()                                                          */
+/*----------------------------------------------------------------------------*/
+static void espsim_cipstart(const char* acArgs)
+{
+  char acLine[16];
+  unsigned long uiLink = strtoul(acArgs, 0, 10);
+
+  if ((uiLink > 4) || (0 == strstr(acArgs, ",\"UDP\",")))
+  {
+    espsim_queue(0, "ERROR");
+  }
+  else if (0 != (g_tSim.uiLinks & (1 << uiLink)))
+  {
+    espsim_queue(0, "ALREADY CONNECTED");
+    espsim_queue(0, "");
+    espsim_queue(0, "ERROR");
+  }
+  else
+  {
+    g_tSim.uiLinks |= (uint8_t) (1 << uiLink);
+
+    snprintf(acLine, sizeof(acLine), "%lu,CONNECT", uiLink);
+    espsim_queue(0, acLine);
+    espsim_queue(0, "");
+    espsim_queue(0, "OK");
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* espsim_connect()                                                           */
+/*----------------------------------------------------------------------------*/
+static void espsim_connect(const char* acArgs)
+{
+  const char* pPort = strrchr(acArgs, ',');
+  unsigned long uiPort = (pPort ? strtoul(pPort + 1, 0, 10) : 0);
+  int32_t iTime = g_tSim.uiRtt;
+
+  if (g_tSim.bConnected)
+  {
+    espsim_queue(0, "ALREADY CONNECTED");
+    espsim_queue(0, "");
+    espsim_queue(0, "ERROR");
+    return;
+  }
+
+  ++g_tSim.uiPings;
+
+  if (0 != g_tSim.uiJitter)
+  {
+    iTime += (int32_t) (espsim_random() % (2U * g_tSim.uiJitter + 1U)) - g_tSim.uiJitter;
+    iTime  = (iTime < 0 ? 0 : iTime);
+  }
+
+  if ((0 == uiPort) || (uiPort == g_tSim.uiRefused))
+  {
+    /* RST of the host */
+    espsim_queue(iTime * 1000ULL, "ERROR");
+    espsim_queue(iTime * 1000ULL, "CLOSED");
+  }
+  else if ((espsim_random() % 100) < g_tSim.uiLoss)
+  {
+    espsim_queue(uiESPSIM_CONNECT_TIMEOUT * 1000ULL, "ERROR");
+    espsim_queue(uiESPSIM_CONNECT_TIMEOUT * 1000ULL, "CLOSED");
+  }
+  else
+  {
+    g_tSim.bConnected = true;
+    espsim_queue(iTime * 1000ULL, "CONNECT");
+    espsim_queue(iTime * 1000ULL, "");
+    espsim_queue(iTime * 1000ULL, "OK");
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* espsim_echo()                                                              */
+/*----------------------------------------------------------------------------*/
+static void espsim_echo(const char* acData)
+{
+  char acLine[uiESPSIM_LINE];
+  size_t uiLen = strlen(acData);
+
+  ++g_tSim.uiPings;
+
+  snprintf(acLine, sizeof(acLine), "Recv %u bytes", (unsigned) uiLen);
+  espsim_queue(0, "");
+  espsim_queue(0, acLine);
+  espsim_queue(0, "");
+  espsim_queue(0, "SEND OK");
+
+  if ((espsim_random() % 100) >= g_tSim.uiLoss)
+  {
+    int32_t iTime = g_tSim.uiRtt * 1000;
+
+    /* Jitter [us], so the replies of probes in flight may overtake each other */
+    if (0 != g_tSim.uiJitter)
+    {
+      iTime += (int32_t) (espsim_random() % (2000U * g_tSim.uiJitter + 1U)) - (1000 * g_tSim.uiJitter);
+      iTime  = (iTime < 0 ? 0 : iTime);
+    }
+
+    snprintf(acLine, sizeof(acLine), "\r\n+IPD,%d,%u:%s", g_tSim.iSendLink, (unsigned) uiLen, acData);
+    espsim_queue_raw((uint64_t) iTime, acLine);
+
+    if ((espsim_random() % 100) < g_tSim.uiDup)
+    {
+      espsim_queue_raw((uint64_t) iTime + 1000, acLine);
+    }
+  }
+
+  g_tSim.iSendLink = -1;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* espsim_sink()                                                              */
+/*----------------------------------------------------------------------------*/
+static void espsim_sink(const char* acData)
+{
+  char acLine[32];
+  size_t uiLen = strlen(acData);
+
+  /* Bytes beyond the announced length are the next command */
+  uiLen = (uiLen < g_tSim.uiSendLeft ? uiLen : g_tSim.uiSendLeft);
+
+  g_tSim.uiSunk     += uiLen;
+  g_tSim.uiSendLeft -= (uint16_t) uiLen;
+
+  if (0 == g_tSim.uiSendLeft)
+  {
+    uint64_t uiWifi = (0 != g_tSim.uiWifi ? (g_tSim.uiSendLen * 8000ULL) / g_tSim.uiWifi : 0);
+
+    ++g_tSim.uiPings;
+
+    snprintf(acLine, sizeof(acLine), "Recv %u bytes", g_tSim.uiSendLen);
+    espsim_queue(0, "");
+    espsim_queue(0, acLine);
+    espsim_queue(uiWifi + g_tSim.uiRtt * 1000ULL, "");
+    espsim_queue(uiWifi + g_tSim.uiRtt * 1000ULL, "SEND OK");
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* espsim_flush()                                                             */
+/*----------------------------------------------------------------------------*/
+void espsim_flush(void)
+{
+  espsim_get()->uiHead = g_tSim.uiTail;
+  g_tSim.uiPos = 0;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* espsim_due()                                                               */
+/*----------------------------------------------------------------------------*/
+static uint64_t espsim_due(void)
+{
+  const espsim_line_t* pLine = &g_tSim.atQueue[g_tSim.uiHead];
+  size_t uiLen = strlen(pLine->acText);
+
+  return pLine->uiDue - ((uiLen - g_tSim.uiPos - 1) * ESPSIM_BYTE_TIME(pLine->uiBaud)) / 1000;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* espsim_poll()                                                              */
+/*----------------------------------------------------------------------------*/
+void espsim_poll(uint64_t uiMicros)
+{
+  espsim_get();
+
+  if (g_tSim.uiHead != g_tSim.uiTail)
+  {
+    uint64_t uiDue = espsim_due();
+
+    if (uiDue <= g_tSim.uiClock)
+    {
+      return;
+    }
+
+    if ((uiDue - g_tSim.uiClock) < uiMicros)
+    {
+      uiMicros = uiDue - g_tSim.uiClock;
+    }
+  }
+
+  espsim_advance(uiMicros);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* espsim_getc()                                                              */
+/*----------------------------------------------------------------------------*/
+int espsim_getc(void)
+{
+  espsim_get();
+
+  if (g_tSim.uiHead == g_tSim.uiTail)
+  {
+    return -1;
+  }
+
+  espsim_line_t* pLine = &g_tSim.atQueue[g_tSim.uiHead];
+  size_t uiLen = strlen(pLine->acText);
+
+  if (espsim_due() > g_tSim.uiClock)
+  {
+    return -1;
+  }
+
+  if (g_tSim.bTrace && (0 == g_tSim.uiPos))
+  {
+    fprintf(stderr, "espsim< %s", pLine->acText);
+  }
+
+  int iByte = (uint8_t) pLine->acText[g_tSim.uiPos++];
+
+  /* Wrong baudrate or too fast for the Next: framing errors */
+  if ((pLine->uiBaud != g_tSim.uiNextBaud) || (pLine->uiBaud > g_tSim.uiMaxBaud))
+  {
+    iByte = 0xFF & ~iByte;
+  }
+
+  if (g_tSim.uiPos >= uiLen)
+  {
+    g_tSim.uiHead = (uint8_t) ((g_tSim.uiHead + 1) % uiESPSIM_QUEUE);
+    g_tSim.uiPos  = 0;
+  }
+
+  return iByte;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* esp_open()                                                                 */
+/*----------------------------------------------------------------------------*/
+int esp_open(esp_t* pEsp)
+{
+  (void) pEsp;
+  espsim_get();
+  return EOK;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* esp_close()                                                                */
+/*----------------------------------------------------------------------------*/
+int esp_close(esp_t* pEsp)
+{
+  (void) pEsp;
+  return EOK;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* esp_flush()                                                                */
+/*----------------------------------------------------------------------------*/
+int esp_flush(esp_t* pEsp)
+{
+  (void) pEsp;
+  espsim_flush();
+  return EOK;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* esp_transmit()                                                             */
+/*----------------------------------------------------------------------------*/
+int esp_transmit(esp_t* pEsp, const char_t* acCmd)
+{
+  (void) pEsp;
+  espsim_get();
+
+  if (g_tSim.bTrace)
+  {
+    fprintf(stderr, "espsim> %s", acCmd);
+  }
+
+  /* The escape sequence of the passthrough needs a pause before it */
+  bool bGap = ((g_tSim.uiClock - g_tSim.uiLastTx) >= (uiESPSIM_ESCAPE_GAP * 1000ULL));
+
+  /* Serialization of the command */
+  espsim_advance((strlen(acCmd) * ESPSIM_BYTE_TIME(g_tSim.uiNextBaud)) / 1000);
+  g_tSim.uiLastTx = g_tSim.uiClock;
+
+  if (0 != g_tSim.auiReplay)
+  {
+    espsim_replay(acCmd);
+  }
+  else if (g_tSim.uiEspBaud != g_tSim.uiNextBaud)
+  {
+    /* Command is not understood */
+  }
+  else if (g_tSim.bStreaming)
+  {
+    if (bGap && (0 == strcmp(acCmd, "+++")))
+    {
+      g_tSim.bStreaming = false;
+    }
+    else
+    {
+      /* The sink is faster than the UART */
+      g_tSim.uiSunk += strlen(acCmd);
+      ++g_tSim.uiPings;
+    }
+  }
+  else if (0 <= g_tSim.iSendLink)
+  {
+    espsim_echo(acCmd);
+  }
+  else if (0 != g_tSim.uiSendLeft)
+  {
+    espsim_sink(acCmd);
+  }
+  else if (0 == strcmp(acCmd, "AT+CIPMODE=1\r\n") || (0 == strcmp(acCmd, "AT+CIPMODE=0\r\n")))
+  {
+    g_tSim.bPassthrough = ('1' == acCmd[11]);
+    espsim_queue(0, "OK");
+  }
+  else if (0 == strcmp(acCmd, "AT+CIPSEND\r\n"))
+  {
+    if (g_tSim.bConnected && g_tSim.bPassthrough)
+    {
+      g_tSim.bStreaming = true;
+      espsim_queue(0, "");
+      espsim_queue(0, "OK");
+      espsim_queue_raw(0, ">");
+    }
+    else
+    {
+      espsim_queue(0, "ERROR");
+    }
+  }
+  else if (0 == strcmp(acCmd, "AT+CIPMUX=1\r\n") || (0 == strcmp(acCmd, "AT+CIPMUX=0\r\n")))
+  {
+    espsim_queue(0, "OK");
+  }
+  else if (0 == strncmp(acCmd, "AT+CIPSTART=\"TCP\",", 18))
+  {
+    espsim_connect(acCmd + 18);
+  }
+  else if (0 == strncmp(acCmd, "AT+CIPSTART=", 12))
+  {
+    espsim_cipstart(acCmd + 12);
+  }
+  else if (0 == strcmp(acCmd, "AT+CIPCLOSE\r\n"))
+  {
+    if (g_tSim.bConnected)
+    {
+      g_tSim.bConnected = false;
+      espsim_queue(0, "CLOSED");
+      espsim_queue(0, "");
+      espsim_queue(0, "OK");
+    }
+    else
+    {
+      espsim_queue(0, "ERROR");
+    }
+  }
+  else if ((0 == strncmp(acCmd, "AT+CIPSEND=", 11)) && (0 == g_tSim.uiLinks))
+  {
+    unsigned long uiLen = strtoul(acCmd + 11, 0, 10);
+
+    if (g_tSim.bConnected && !g_tSim.bPassthrough && (0 != uiLen) && (uiESPSIM_MAX_SEND >= uiLen))
+    {
+      g_tSim.uiSendLeft = (uint16_t) uiLen;
+      g_tSim.uiSendLen  = (uint16_t) uiLen;
+      espsim_queue(0, "");
+      espsim_queue(0, "OK");
+      espsim_queue_raw(0, "> ");
+    }
+    else if (g_tSim.bConnected)
+    {
+      espsim_queue(0, "ERROR");
+    }
+    else
+    {
+      espsim_queue(0, "link is not valid");
+      espsim_queue(0, "");
+      espsim_queue(0, "ERROR");
+    }
+  }
+  else if (0 == strncmp(acCmd, "AT+CIPSEND=", 11))
+  {
+    unsigned long uiLink = strtoul(acCmd + 11, 0, 10);
+
+    if ((uiLink <= 4) && (0 != (g_tSim.uiLinks & (1 << uiLink))))
+    {
+      g_tSim.iSendLink = (int8_t) uiLink;
+      espsim_queue(0, "");
+      espsim_queue(0, "OK");
+      espsim_queue_raw(0, "> ");
+    }
+    else
+    {
+      espsim_queue(0, "link is not valid");
+      espsim_queue(0, "");
+      espsim_queue(0, "ERROR");
+    }
+  }
+  else if (0 == strcmp(acCmd, "AT+CIPCLOSE=5\r\n"))
+  {
+    for (uint8_t i = 0; i <= 4; ++i)
+    {
+      if (0 != (g_tSim.uiLinks & (1 << i)))
+      {
+        char acLine[16];
+        snprintf(acLine, sizeof(acLine), "%u,CLOSED", i);
+        espsim_queue(0, acLine);
+      }
+    }
+
+    g_tSim.uiLinks = 0;
+    espsim_queue(0, "");
+    espsim_queue(0, "OK");
+  }
+  else if (0 == strncmp(acCmd, "AT+PING=\"", 9))
+  {
+    espsim_ping(acCmd + 9);
+  }
+  else if (0 == strncmp(acCmd, "AT+CIPDOMAIN=\"", 14))
+  {
+    espsim_domain(acCmd + 14);
+  }
+  else if (0 == strcmp(acCmd, "AT+GMR\r\n"))
+  {
+    espsim_queue(0, "AT version:1.2.0.0(Jul  1 2016 20:04:45)");
+    espsim_queue(0, "SDK version:1.5.4.1(39cb9a32)");
+    espsim_queue(0, "compile time:Jun 29 2017 00:00:00");
+    espsim_queue(0, "OK");
+  }
+  else if (0 == strcmp(acCmd, "AT+CIPSTA_CUR?\r\n"))
+  {
+    espsim_queue(0, "+CIPSTA_CUR:ip:\"192.168.1.100\"");
+    espsim_queue(0, "+CIPSTA_CUR:gateway:\"192.168.1.1\"");
+    espsim_queue(0, "+CIPSTA_CUR:netmask:\"255.255.255.0\"");
+    espsim_queue(0, "OK");
+  }
+  else if (0 == strncmp(acCmd, "AT+UART_CUR=", 12))
+  {
+    /* "OK" is sent with the old baudrate */
+    espsim_queue(0, "OK");
+    g_tSim.uiEspBaud = strtoul(acCmd + 12, 0, 10);
+  }
+  else if (0 == strcmp(acCmd, "AT\r\n"))
+  {
+    espsim_queue(0, "OK");
+  }
+  else
+  {
+    espsim_queue(0, "ERROR");
+  }
+
+  return EOK;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* esp_receive_ex()                                                           */
+/*----------------------------------------------------------------------------*/
+uint8_t esp_receive_ex(esp_t* pEsp, char_t* acBuffer, size_t uiSize)
+{
+  (void) pEsp;
+  espsim_get();
+
+  for ( ; ; )
+  {
+    if (g_tSim.uiHead == g_tSim.uiTail)
+    {
+      espsim_advance(uiESPSIM_RX_TIMEOUT * 1000ULL);
+      return ESP_LINE_TIMEOUT;
+    }
+
+    espsim_line_t* pLine = &g_tSim.atQueue[g_tSim.uiHead];
+    uint16_t uiPos = g_tSim.uiPos;
+    g_tSim.uiHead = (uint8_t) ((g_tSim.uiHead + 1) % uiESPSIM_QUEUE);
+    g_tSim.uiPos  = 0;
+
+    if (pLine->uiDue > g_tSim.uiClock)
+    {
+      espsim_advance(pLine->uiDue - g_tSim.uiClock);
+    }
+
+    if (g_tSim.bTrace && (0 == uiPos))
+    {
+      fprintf(stderr, "espsim< %s", pLine->acText);
+    }
+
+    /* Empty lines are skipped */
+    if (('\r' == pLine->acText[uiPos]) || ('\n' == pLine->acText[uiPos]))
+    {
+      continue;
+    }
+
+    snprintf(acBuffer, uiSize, "%s", &pLine->acText[uiPos]);
+
+    if (0 == strcmp(&pLine->acText[uiPos], "OK\r\n"))
+    {
+      return ESP_LINE_OK;
+    }
+    else if (0 == strcmp(&pLine->acText[uiPos], "ERROR\r\n"))
+    {
+      return ESP_LINE_ERROR;
+    }
+    else if (0 == strcmp(&pLine->acText[uiPos], "FAIL\r\n"))
+    {
+      return ESP_LINE_FAIL;
+    }
+
+    return ESP_LINE_DATA;
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
@@ -0,0 +1,233 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: monitor.c                                                          |
+| project:  ZX Spectrum Next - PING                                            |
+| author:   Stefan Zell                                                        |
+| date:     16/10/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Host stand-in of the resident monitor                                        |
+|                                                                              |
+| Replaces "src/monitor.c": the driver is installed if the file given by       |
+| ESPSIM_MONITOR exists (".install"); the file holds the shared memory block,  |
+| so it survives from one run to the next. The stand-in does not ping.         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 16/10/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include "libzxn.h"
+#include "monitor.h"
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+/*!
+Shared memory block of the driver
+*/
+static monitor_block_t g_tBlock;
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+/*!
+Read the shared memory block from the file of the driver ("ESPSIM_MONITOR")
+@return "true" = the driver is installed
+*/
+static bool monitor_load(void);
+
+/*!
+Write the shared memory block to the file of the driver
+*/
+static void monitor_save(void);
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/* monitor_load()                                                             */
+/*----------------------------------------------------------------------------*/
+static bool monitor_load(void)
+{
+  const char* acFile = getenv("ESPSIM_MONITOR");
+  FILE* pFile;
+
+  if (!acFile || !*acFile || !(pFile = fopen(acFile, "rb")))
+  {
+    return false;
+  }
+
+  /* An empty file is a freshly installed driver */
+  memset(&g_tBlock, 0, sizeof(g_tBlock));
+
+  if (sizeof(g_tBlock) != fread(&g_tBlock, 1, sizeof(g_tBlock), pFile))
+  {
+    memset(&g_tBlock, 0, sizeof(g_tBlock));
+  }
+
+  fclose(pFile);
+
+  return true;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* monitor_save()                                                             */
+/*----------------------------------------------------------------------------*/
+static void monitor_save(void)
+{
+  FILE* pFile = fopen(getenv("ESPSIM_MONITOR"), "wb");
+
+  if (pFile)
+  {
+    fwrite(&g_tBlock, 1, sizeof(g_tBlock), pFile);
+    fclose(pFile);
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* monitor_pause()                                                            */
+/*----------------------------------------------------------------------------*/
+bool monitor_pause(bool bPause)
+{
+  if (!monitor_load())
+  {
+    return false;
+  }
+
+  if (uiMONITOR_STATE_STOPPED != g_tBlock.uiState)
+  {
+    g_tBlock.uiState = (bPause ? (uiMONITOR_STATE_IDLE | uiMONITOR_STATE_PAUSED)
+                               : (g_tBlock.uiState & ~uiMONITOR_STATE_PAUSED));
+  }
+
+  monitor_save();
+
+  return true;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* monitor_start()                                                            */
+/*----------------------------------------------------------------------------*/
+int monitor_start(const char* acCmd, uint32_t uiAddr, uint16_t uiInterval)
+{
+  uint8_t uiState;
+
+  /* The stand-in does not probe, so the interval is not used */
+  (void) uiInterval;
+
+  if (!monitor_load())
+  {
+    return ENOTSUP;
+  }
+
+  if (uiMONITOR_CMD_SIZE < strlen(acCmd))
+  {
+    return ENOTSUP;
+  }
+
+  uiState = g_tBlock.uiState & uiMONITOR_STATE_PAUSED;
+
+  memset(&g_tBlock, 0, sizeof(g_tBlock));
+  memcpy(g_tBlock.acSignature, "PM", 2);
+  g_tBlock.uiState    = uiMONITOR_STATE_IDLE | uiState;
+  g_tBlock.uiMin      = UINT16_MAX;
+  g_tBlock.auiAddr[0] = (uint8_t) (uiAddr >> 24);
+  g_tBlock.auiAddr[1] = (uint8_t) (uiAddr >> 16);
+  g_tBlock.auiAddr[2] = (uint8_t) (uiAddr >>  8);
+  g_tBlock.auiAddr[3] = (uint8_t) (uiAddr);
+
+  monitor_save();
+
+  return EOK;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* monitor_uninstall()                                                        */
+/*----------------------------------------------------------------------------*/
+int monitor_uninstall(void)
+{
+  if (!monitor_load())
+  {
+    return ENOTSUP;
+  }
+
+  /* ".uninstall" */
+  g_tBlock.uiState = uiMONITOR_STATE_STOPPED;
+  remove(getenv("ESPSIM_MONITOR"));
+
+  return EOK;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* monitor_block()                                                            */
+/*----------------------------------------------------------------------------*/
+const monitor_block_t* monitor_block(void)
+{
+  return &g_tBlock;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
@@ -0,0 +1,115 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: statexp.c                                                          |
+| project:  ZX Spectrum Next - PING                                            |
+| author:   Stefan Zell                                                        |
+| date:     16/10/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Host stand-in of the export of the statistics                                |
+|                                                                              |
+| Replaces "src/statexp.c": the block is written to the file given by          |
+| ESPSIM_EXPORT, the integer variables are printed to stderr if ESPSIM_TRACE   |
+| is set.                                                                      |
+|                                                                              |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "libzxn.h"
+#include "espsim.h"
+#include "statexp.h"
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/* statexp_write()                                                            */
+/*----------------------------------------------------------------------------*/
+void statexp_write(const statexp_t* pBlock, uint8_t uiBank, uint16_t uiAddr)
+{
+  const char* acFile = getenv("ESPSIM_EXPORT");
+  FILE* pFile;
+
+  if (espsim_get()->bTrace)
+  {
+    fprintf(stderr, "statexp: bank %u, address %u\n", uiBank, uiAddr);
+  }
+
+  if (acFile && (0 != (pFile = fopen(acFile, "wb"))))
+  {
+    fwrite(pBlock, 1, sizeof(*pBlock), pFile);
+    fclose(pFile);
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* statexp_basic()                                                            */
+/*----------------------------------------------------------------------------*/
+bool statexp_basic(const statexp_t* pBlock, uint8_t uiVar)
+{
+  const uint16_t auiValue[uiSTATEXP_VARS] =
+  {
+    pBlock->uiResult, pBlock->uiSent, pBlock->uiReceived, pBlock->uiLoss,
+    pBlock->uiMin, pBlock->uiAvg, pBlock->uiMax
+  };
+
+  if (espsim_get()->bTrace)
+  {
+    for (uint8_t i = 0; i < uiSTATEXP_VARS; ++i)
+    {
+      fprintf(stderr, "statexp: %%%c=%u\n", 'a' + uiVar + i, auiValue[i]);
+    }
+  }
+
+  return true;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
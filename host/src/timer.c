@@ -0,0 +1,147 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: timer.c                                                            |
+| project:  ZX Spectrum Next - PING                                            |
+| author:   Stefan Zell                                                        |
+| date:     16/10/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Time base of the application based on the simulated time of the ESP8266      |
+| stand-in (host build only)                                                   |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 16/10/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "timer.h"
+#include "espsim.h"
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+Duration of one tick [us]
+*/
+#define uiTIMER_TICK_US (1000 / uiTIMER_TICKS_PER_MS)
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/* timer_init()                                                               */
+/*----------------------------------------------------------------------------*/
+void timer_init(void)
+{
+  espsim_get();
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* timer_exit()                                                               */
+/*----------------------------------------------------------------------------*/
+void timer_exit(void)
+{
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* timer_now()                                                                */
+/*----------------------------------------------------------------------------*/
+uint32_t timer_now(void)
+{
+  return (uint32_t) (espsim_get()->uiClock / uiTIMER_TICK_US);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* timer_from_ms()                                                            */
+/*----------------------------------------------------------------------------*/
+uint32_t timer_from_ms(uint32_t uiMs)
+{
+  /* The simulated clock runs at exactly 10 kHz */
+  return uiMs * uiTIMER_TICKS_PER_MS;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* timer_to_100us()                                                           */
+/*----------------------------------------------------------------------------*/
+uint32_t timer_to_100us(uint32_t uiTicks)
+{
+  return uiTicks;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* timer_wait_until()                                                         */
+/*----------------------------------------------------------------------------*/
+void timer_wait_until(uint32_t uiDeadline)
+{
+  uint32_t uiNow = timer_now();
+
+  if (TIMER_BEFORE(uiNow, uiDeadline))
+  {
+    espsim_advance((uint64_t) (uiDeadline - uiNow) * uiTIMER_TICK_US);
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
@@ -0,0 +1,471 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: zxnsim.c                                                           |
+| project:  ZX Spectrum Next - PING                                            |
+| author:   Stefan Zell                                                        |
+| date:     16/10/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Host implementation of the "libzxn", keyboard and esxDOS functions used      |
+| by the application (host build only)                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 16/10/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "libzxn.h"
+#include <arch/zxn.h>
+#include <arch/zxn/esxdos.h>
+#include <input.h>
+#include "espsim.h"
+#include "dnscache.h"
+#include "espready.h"
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+/*!
+Simulated speed of the Z80N
+*/
+static uint8_t g_uiSpeed = RTM_3MHZ;
+
+/*!
+If this flag is set, the simulated user break has already been reported
+*/
+static bool g_bBreak = false;
+
+/*!
+ULA screen (bitmap and attributes); written to the file given by
+"ESPSIM_SCREEN" (PBM) at exit, if the screen was used
+*/
+static uint8_t g_auiScreen[0x1B00];
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+/*!
+Write the ULA screen to the file given by "ESPSIM_SCREEN" (PBM)
+*/
+static void zx_dump(void);
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/* zxn_getspeed()                                                             */
+/*----------------------------------------------------------------------------*/
+uint8_t zxn_getspeed(void)
+{
+  return g_uiSpeed;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* zxn_setspeed()                                                             */
+/*----------------------------------------------------------------------------*/
+void zxn_setspeed(uint8_t uiSpeed)
+{
+  g_uiSpeed = uiSpeed;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* zxn_sleep_ms()                                                             */
+/*----------------------------------------------------------------------------*/
+void zxn_sleep_ms(uint16_t uiTime)
+{
+  espsim_get();
+  espsim_advance(uiTime * 1000ULL);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* zxn_rtrim()                                                                */
+/*----------------------------------------------------------------------------*/
+char_t* zxn_rtrim(char_t* acString)
+{
+  size_t uiLen = strlen(acString);
+
+  while ((0 != uiLen) && isspace((unsigned char) acString[uiLen - 1]))
+  {
+    acString[--uiLen] = '\0';
+  }
+
+  return acString;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* zxn_strerror()                                                             */
+/*----------------------------------------------------------------------------*/
+int zxn_strerror(int iCode)
+{
+  return iCode;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* stricmp()                                                                  */
+/*----------------------------------------------------------------------------*/
+int stricmp(const char* s1, const char* s2)
+{
+  int iDiff;
+
+  do
+  {
+    iDiff = tolower((unsigned char) *s1) - tolower((unsigned char) *s2);
+  }
+  while ((0 == iDiff) && ('\0' != *s1++) && ('\0' != *s2++));
+
+  return iDiff;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* strupr()                                                                   */
+/*----------------------------------------------------------------------------*/
+char* strupr(char* s)
+{
+  for (char* p = s; '\0' != *p; ++p)
+  {
+    *p = (char) toupper((unsigned char) *p);
+  }
+
+  return s;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* in_inkey()                                                                 */
+/*----------------------------------------------------------------------------*/
+int in_inkey(void)
+{
+  espsim_t* pSim = espsim_get();
+
+  /* Simulated user break is a single key press after the response; UDP echo
+     probes are always in flight */
+  if ((0 != pSim->uiBreak) && !g_bBreak && (pSim->uiPings >= pSim->uiBreak) &&
+      ((pSim->uiHead == pSim->uiTail) || (0 != pSim->uiLinks)))
+  {
+    g_bBreak = true;
+    return 'q';
+  }
+
+  return 0;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* in_key_pressed()                                                           */
+/*----------------------------------------------------------------------------*/
+int in_key_pressed(uint16_t uiScancode)
+{
+  (void) uiScancode;
+  return 0;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* esx_m_dosversion()                                                         */
+/*----------------------------------------------------------------------------*/
+uint16_t esx_m_dosversion(void)
+{
+  return 0x0207;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* esx_m_getdate()                                                            */
+/*----------------------------------------------------------------------------*/
+unsigned char esx_m_getdate(struct dos_tm* tm)
+{
+  time_t tNow = time(0);
+  struct tm* pNow = localtime(&tNow);
+
+  tm->date = (uint16_t) (((pNow->tm_year - 80) << 9) | ((pNow->tm_mon + 1) << 5) | pNow->tm_mday);
+  tm->time = (uint16_t) ((pNow->tm_hour << 11) | (pNow->tm_min << 5) | (pNow->tm_sec / 2));
+
+  return 0;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* esx_f_open()                                                               */
+/*----------------------------------------------------------------------------*/
+unsigned char esx_f_open(char* filename, unsigned char mode)
+{
+  int iFlags;
+  int iFd;
+
+  /* A replay does not depend on (or change) the state of earlier runs */
+  if (getenv("ESPSIM_REPLAY") &&
+      ((0 == strcmp(filename, sDNSCACHE_FILE)) || (0 == strcmp(filename, sESPREADY_FILE))))
+  {
+    return ESX_HANDLE_INVALID;
+  }
+
+  switch (mode & (ESX_MODE_READ | ESX_MODE_WRITE))
+  {
+    case ESX_MODE_WRITE:
+      iFlags = O_WRONLY;
+      break;
+
+    case ESX_MODE_READ | ESX_MODE_WRITE:
+      iFlags = O_RDWR;
+      break;
+
+    default:
+      iFlags = O_RDONLY;
+      break;
+  }
+
+  switch (mode & ESX_MODE_CREAT_TRUNC)
+  {
+    case ESX_MODE_OPEN_CREAT:
+      iFlags |= O_CREAT;
+      break;
+
+    case ESX_MODE_CREAT_NOEXIST:
+      iFlags |= O_CREAT | O_EXCL;
+      break;
+
+    case ESX_MODE_CREAT_TRUNC:
+      iFlags |= O_CREAT | O_TRUNC;
+      break;
+  }
+
+  if ((0 > (iFd = open(filename, iFlags, 0644))) || (ESX_HANDLE_INVALID <= iFd))
+  {
+    return ESX_HANDLE_INVALID;
+  }
+
+  return (unsigned char) iFd;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* esx_f_close()                                                              */
+/*----------------------------------------------------------------------------*/
+unsigned char esx_f_close(unsigned char handle)
+{
+  return (0 == close(handle) ? 0 : 0xFF);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* esx_f_read()                                                               */
+/*----------------------------------------------------------------------------*/
+uint16_t esx_f_read(unsigned char handle, void* dst, size_t len)
+{
+  ssize_t iLen = read(handle, dst, len);
+  return (0 <= iLen ? (uint16_t) iLen : 0);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* esx_f_write()                                                              */
+/*----------------------------------------------------------------------------*/
+uint16_t esx_f_write(unsigned char handle, void* src, size_t len)
+{
+  ssize_t iLen = write(handle, src, len);
+  return (0 <= iLen ? (uint16_t) iLen : 0);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* esx_f_seek()                                                               */
+/*----------------------------------------------------------------------------*/
+uint32_t esx_f_seek(unsigned char handle, uint32_t distance, unsigned char whence)
+{
+  off_t iPos;
+
+  switch (whence)
+  {
+    case ESX_SEEK_FWD:
+      iPos = lseek(handle, distance, SEEK_CUR);
+      break;
+
+    case ESX_SEEK_BWD:
+      iPos = lseek(handle, -((off_t) distance), SEEK_CUR);
+      break;
+
+    default:
+      iPos = lseek(handle, distance, SEEK_SET);
+      break;
+  }
+
+  return (uint32_t) iPos;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* esx_f_fstat()                                                              */
+/*----------------------------------------------------------------------------*/
+unsigned char esx_f_fstat(unsigned char handle, struct esx_stat* es)
+{
+  struct stat tStat;
+
+  if (0 != fstat(handle, &tStat))
+  {
+    return 0xFF;
+  }
+
+  memset(es, 0, sizeof(*es));
+  es->size = (uint32_t) tStat.st_size;
+
+  return 0;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* zx_cls()                                                                   */
+/*----------------------------------------------------------------------------*/
+void zx_cls(unsigned char attr)
+{
+  static bool bRegistered = false;
+
+  memset(g_auiScreen, 0, 0x1800);
+  memset(g_auiScreen + 0x1800, attr, 0x300);
+
+  if (!bRegistered)
+  {
+    atexit(zx_dump);
+    bRegistered = true;
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* zx_cxy2saddr()                                                             */
+/*----------------------------------------------------------------------------*/
+unsigned char* zx_cxy2saddr(unsigned char x, unsigned char y)
+{
+  return zx_pxy2saddr((unsigned char) (x << 3), (unsigned char) (y << 3));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* zx_cxy2aaddr()                                                             */
+/*----------------------------------------------------------------------------*/
+unsigned char* zx_cxy2aaddr(unsigned char x, unsigned char y)
+{
+  return &g_auiScreen[0x1800 + (y << 5) + x];
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* zx_pxy2saddr()                                                             */
+/*----------------------------------------------------------------------------*/
+unsigned char* zx_pxy2saddr(unsigned char x, unsigned char y)
+{
+  return &g_auiScreen[((y & 0xC0) << 5) | ((y & 0x07) << 8) | ((y & 0x38) << 2) | (x >> 3)];
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* zx_px2bitmask()                                                            */
+/*----------------------------------------------------------------------------*/
+unsigned char zx_px2bitmask(unsigned char x)
+{
+  return (unsigned char) (0x80 >> (x & 0x07));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* zx_saddrpdown()                                                            */
+/*----------------------------------------------------------------------------*/
+unsigned char* zx_saddrpdown(void* saddr)
+{
+  uint16_t uiAddr = (uint16_t) (((unsigned char*) saddr) - g_auiScreen);
+  uint8_t y = (uint8_t) (((uiAddr >> 5) & 0xC0) | ((uiAddr >> 8) & 0x07) | ((uiAddr >> 2) & 0x38));
+
+  return zx_pxy2saddr((unsigned char) ((uiAddr & 0x1F) << 3), (unsigned char) (y + 1));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* zx_dump()                                                                  */
+/*----------------------------------------------------------------------------*/
+static void zx_dump(void)
+{
+  const char* acFile = getenv("ESPSIM_SCREEN");
+  FILE* pFile;
+
+  if (acFile && (0 != (pFile = fopen(acFile, "wb"))))
+  {
+    fprintf(pFile, "P4\n256 192\n");
+
+    for (unsigned int y = 0; y < 192; ++y)
+    {
+      fwrite(zx_pxy2saddr(0, (unsigned char) y), 1, 32, pFile);
+    }
+
+    fclose(pFile);
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
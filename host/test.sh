@@ -0,0 +1,143 @@
+#!/bin/sh
+#------------------------------------------------------------------------------
+# test.sh - runs the host build against the simulated ESP8266
+#
+# usage: test.sh app
+#
+# Each case runs the host build ("make host") with the given options and
+# checks its exit code and a pattern of its output (stdout and stderr). The
+# simulator is configured per case by ESPSIM_xxx variables (see
+# "inc/espsim.h"); files of the cases are kept in a temporary directory.
+#------------------------------------------------------------------------------
+
+APP=$1
+WORK=$(mktemp -d)
+RESULT=0
+
+trap 'rm -rf "$WORK"' EXIT
+
+# Run one case: check NAME RC PATTERN OPTIONS...
+check()
+{
+  NAME=$1
+  EXPECT=$2
+  PATTERN=$3
+  shift 3
+
+  OUTPUT=$("$APP" "$@" 2>&1)
+  CODE=$?
+
+  if [ "$CODE" -eq "$EXPECT" ] && printf "%s\n" "$OUTPUT" | grep -q -- "$PATTERN"; then
+    printf "%-24s ok\n" "$NAME"
+  else
+    printf "%-24s FAILED (exit code %s, expected %s)\n" "$NAME" "$CODE" "$EXPECT"
+    printf "%s\n" "$OUTPUT" | sed 's/^/  | /'
+    RESULT=1
+  fi
+}
+
+if [ ! -x "$APP" ]; then
+  echo "test: \"$APP\" not found (make host)" >&2
+  exit 1
+fi
+
+### Address ranges ###
+check "range"                   0 "3 hosts, 3 up"              10.0.0.1-3
+check "range reversed"         22 "invalid range"              192.168.1.250-3
+check "range not numeric"      22 "invalid range"              192.168.1.x-y
+check "hostname with dash"      0 "3 received"                 my-host.lan -c 3
+
+### Batch ("-f") ###
+# Options of a single host are rejected instead of being ignored
+printf '10.0.0.1\n10.0.0.2 2\n' > "$WORK/hosts.txt"
+check "batch"                   0 "2 hosts, 2 up"         -f "$WORK/hosts.txt" -c 1
+check "batch with tcp"         22 "not with -f"           -f "$WORK/hosts.txt" -p 80
+check "batch with log"         22 "not with -f"           -f "$WORK/hosts.txt" -o "$WORK/batch.log"
+check "batch with slo"         22 "not with -f"           -f "$WORK/hosts.txt" -L 10
+
+### Export ("-x") ###
+# The page of a bank (2 x bank) must exist and fit into the MMU register
+check "export last bank"        0 "3 received"            10.0.0.1 -c 3 -x 111,0
+check "export bank too high"   22 "invalid address"       10.0.0.1 -c 3 -x 112,0
+check "export bank wraps"      22 "invalid address"       10.0.0.1 -c 3 -x 130,0
+
+### Resident monitor ("-M", "-m", "-U") ###
+# The file of ESPSIM_MONITOR is the installed driver
+export ESPSIM_MONITOR="$WORK/pingmon.drv"
+
+check "monitor not installed"  95 "driver not installed"  -m
+touch "$ESPSIM_MONITOR"
+check "monitor start"           0 "monitoring 10.0.0.1"   10.0.0.1 -M
+check "monitor stats"           0 "10.0.0.1: running"     -m
+check "monitor uninstall"       0 "monitor removed"       -U
+check "monitor removed"        95 "driver not installed"  -m
+
+unset ESPSIM_MONITOR
+
+### Baudrate ("-b") ###
+# A baudrate the Next can't receive falls back within the probe timeout
+export ESPSIM_MAXBAUD=1000000
+check "baud fallback quick"     0 "startup [0-9]\{1,3\} ms"     10.0.0.1 -c 1 -b 2000000
+unset ESPSIM_MAXBAUD
+
+### Statistics ###
+# 101 ms is in the bucket 96..103: the percentiles stay within min/max
+export ESPSIM_RTT=101
+check "percentiles in min/max"  0 "p50/p90/p99 = 101/101/101"  10.0.0.1 -c 3
+
+# Service level: loss, average and p95 are checked in this order
+check "slo avg before p95"    113 "avg > 10 ms"           10.0.0.1 -c 3 -A 10 -P 10
+check "slo loss first"        112 "loss > 0%"             10.0.0.1 -c 3 -A 10 -P 10 -L 0 -W 50
+unset ESPSIM_RTT
+
+### TCP connect ("-p") ###
+check "tcp connect"             0 "3 transmitted, 3 received"  10.0.0.1 -p 80 -c 3
+check "tcp connect time"        0 "port 80: time=[0-9]* ms"    10.0.0.1 -p 80 -c 3
+
+# A port without listener refuses every connect
+export ESPSIM_REFUSED=81
+check "tcp no listener"       125 "3 transmitted, 0 received"  10.0.0.1 -p 81 -c 3
+check "tcp connect failed"    125 "connect failed"             10.0.0.1 -p 81 -c 3
+unset ESPSIM_REFUSED
+
+### UDP echo ("-u", "-n") ###
+# The probes are spread over all links of "AT+CIPMUX=1"
+check "udp echo"                0 "10 received"           10.0.0.1 -u 7 -n 5 -c 10 -i 0
+check "udp echo links"          0 "seq=9 link=4"          10.0.0.1 -u 7 -n 5 -c 10 -i 0
+check "udp echo in order"       0 "0 reordered, 0 duplicates, 0 late"  10.0.0.1 -u 7 -n 5 -c 10 -i 0
+
+# Replies after the deadline are not counted
+export ESPSIM_RTT=300
+check "udp echo timeout"      125 "3 transmitted, 0 received"  10.0.0.1 -u 7 -c 3 -W 100
+unset ESPSIM_RTT
+
+### Throughput ("-t") ###
+# AT+CIPSEND per chunk is limited by the prompt, passthrough by the UART
+check "throughput cipsend"      0 "18 of 18 chunks sent"  10.0.0.1 -t 5001 -T 2
+check "cipsend rate"            0 "^89[0-9][0-9] bytes/s" 10.0.0.1 -t 5001 -T 2
+check "throughput raw"          0 "23 of 23 chunks sent"  10.0.0.1 -t 5001 -T 2 -R
+check "raw rate"                0 "^115[0-9][0-9] bytes/s" 10.0.0.1 -t 5001 -T 2 -R
+check "throughput amount"       0 "65536 bytes in .* 64 of 64 chunks sent"  10.0.0.1 -t 5001 -k 64
+check "amount raw"              0 "65536 bytes in .* 64 of 64 chunks sent"  10.0.0.1 -t 5001 -k 64 -R
+
+### Replay of a capture ("-C", ESPSIM_REPLAY) ###
+# The ESP8266 is left idle, so the capture starts with the quick "AT" that
+# the replay (without state files) does not send
+check "capture idle esp"        0 "1 received"            10.0.0.1 -c 1
+check "capture"                 0 "3 received"            10.0.0.1 -c 3 -C "$WORK/esp.cap"
+
+export ESPSIM_REPLAY="$WORK/esp.cap"
+check "replay resync"           0 "3 received, time 60"   10.0.0.1 -c 3
+check "replay mismatch"        95 "not in capture"        10.0.0.2 -c 3
+unset ESPSIM_REPLAY
+
+# "OK" without the time of the ping is no response
+printf 'AT+PING="10.0.0.1"\r\n' > "$WORK/ok.txt"
+printf '\000\000\000\000\000\024' | cat - "$WORK/ok.txt" > "$WORK/ok.cap"
+printf '\310\000\000\000\001\004OK\r\n' >> "$WORK/ok.cap"
+
+export ESPSIM_REPLAY="$WORK/ok.cap"
+check "ok without time"        95 "communication error"   10.0.0.1 -c 1
+unset ESPSIM_REPLAY
+
+exit $RESULT
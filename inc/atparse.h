@@ -0,0 +1,140 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: atparse.h                                                          |
+| project:  ZX Spectrum Next - PING                                            |
+| author:   Stefan Zell                                                        |
+| date:     16/10/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Streaming parser for the responses of the ESP8266 to AT commands             |
+|                                                                              |
+| The parser consumes the bytes received from the UART one by one and emits    |
+| typed events at the end of each line, without buffering the line itself.     |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 16/10/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+#if !defined(__ATPARSE_H__)
+  #define __ATPARSE_H__
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+/*!
+Events of the parser
+*/
+typedef enum _at_event
+{
+  AT_EVENT_NONE = 0, /* no event/line without meaning             */
+  AT_EVENT_VALUE,    /* line "+<n>"; value is stored in "uiValue" */
+  AT_EVENT_OK,       /* line "OK"                                 */
+  AT_EVENT_ERROR,    /* line "ERROR"                              */
+  AT_EVENT_FAIL,     /* line "FAIL"                               */
+  AT_EVENT_CONNECT,  /* line "CONNECT" ("AT+CIPSTART")            */
+  AT_EVENT_BUSY      /* line "busy p..." (emitted immediately)    */
+} at_event_t;
+
+/*!
+State of the parser
+*/
+typedef struct _at_parser
+{
+  /*!
+  Current state of the state machine (AT_STATE_xxx)
+  */
+  uint8_t uiState;
+
+  /*!
+  Position in the current line
+  */
+  uint8_t uiPos;
+
+  /*!
+  Keywords that still match the current line (bitmask)
+  */
+  uint8_t uiMatch;
+
+  /*!
+  Value of the last line "+<n>" (saturated at UINT16_MAX)
+  */
+  uint16_t uiValue;
+} at_parser_t;
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+/*!
+Reset the parser to the start of a line
+@param pParser Parser
+*/
+void at_reset(at_parser_t* pParser);
+
+/*!
+Pass the next received byte to the parser
+@param pParser Parser
+@param uiByte Received byte
+@return Event that is caused by the byte (AT_EVENT_xxx)
+*/
+at_event_t at_parse(at_parser_t* pParser, uint8_t uiByte);
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#endif /* __ATPARSE_H__ */
@@ -0,0 +1,153 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: bankmem.h                                                          |
+| project:  ZX Spectrum Next - PING                                            |
+| author:   Stefan Zell                                                        |
+| date:     16/10/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Arena of 8K memory pages of NextOS                                           |
+|                                                                              |
+| The buffers of the application are not part of the dot command; they are     |
+| allocated in pages reserved from NextOS, which are mapped into an MMU slot.  |
+| The first page is mapped while the application runs (resident memory), the   |
+| other pages are mapped on demand (far memory).                               |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 16/10/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+#if !defined(__BANKMEM_H__)
+  #define __BANKMEM_H__
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+Size of a memory page
+*/
+#define uiBANKMEM_PAGE_SIZE (0x2000)
+
+/*!
+MMU slot the pages are mapped into (0x6000 .. 0x7FFF: neither the dot command,
+nor the screen, the system variables or the stack)
+*/
+#define uiBANKMEM_SLOT (3)
+
+/*!
+Maximum number of pages of the arena (resident page + far pages)
+*/
+#define uiBANKMEM_PAGES (8)
+
+/*!
+Invalid far address
+*/
+#define uiBANKMEM_NULL (0x0000)
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+/*!
+Far address: index of the page in the arena (bits 15:13) and offset in the
+page (bits 12:0)
+*/
+typedef uint16_t bankmem_t;
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+/*!
+Reserve the resident page and map it into the MMU slot
+@return EOK; ENOMEM if NextOS has no free page
+*/
+int bankmem_init(void);
+
+/*!
+Restore the original page of the MMU slot and release all pages
+*/
+void bankmem_exit(void);
+
+/*!
+Allocate memory in the resident page; the memory is valid until
+"bankmem_exit" and must not be used while a far page is mapped.
+@param uiSize Size [bytes]
+@return Pointer to the memory; 0 if the resident page is full
+*/
+void* bankmem_alloc(uint16_t uiSize);
+
+/*!
+Allocate memory in a far page; further pages are reserved from NextOS if
+needed. A block never crosses a page, so it is at most 8K.
+@param uiSize Size [bytes]
+@return Far address of the memory; uiBANKMEM_NULL if no memory is left
+*/
+bankmem_t bankmem_falloc(uint16_t uiSize);
+
+/*!
+Map the page of a far address into the MMU slot; the resident memory is not
+accessible until "bankmem_unmap" is called.
+@param tAddr Far address
+@return Pointer to the memory
+*/
+void* bankmem_map(bankmem_t tAddr);
+
+/*!
+Map the resident page into the MMU slot again
+*/
+void bankmem_unmap(void);
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#endif /* __BANKMEM_H__ */
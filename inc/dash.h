@@ -0,0 +1,121 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: dash.h                                                             |
+| project:  ZX Spectrum Next - PING                                            |
+| author:   Stefan Zell                                                        |
+| date:     16/10/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Live latency graph on the ULA screen ("-d")                                  |
+|                                                                              |
+| Every probe draws one pixel column of the graph and redraws only the digits  |
+| of the counters that have changed, so the cost per probe is constant.        |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 16/10/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+#if !defined(__DASH_H__)
+  #define __DASH_H__
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+/*!
+Counters of the dashboard
+*/
+typedef enum _dash_counter
+{
+  DASH_MIN = 0,
+  DASH_AVG,
+  DASH_MAX,
+  DASH_LOSS,
+  DASH_PINGS,
+  DASH_COUNTERS
+} dash_counter_t;
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+/*!
+Clear the screen and draw the static parts of the dashboard (labels, grid)
+*/
+void dash_init(void);
+
+/*!
+Draw the column of a probe into the graph and clear the following column,
+which marks the current position when the graph wraps around
+@param uiIndex Number of the probe
+@param bOk true = answered, false = lost
+@param uiRtt Round trip time [ms]
+*/
+void dash_column(uint16_t uiIndex, bool bOk, uint16_t uiRtt);
+
+/*!
+Update a counter of the dashboard; only the digits that have changed are
+redrawn
+@param eCounter Counter
+@param uiValue Value (DASH_LOSS in [%])
+*/
+void dash_counter(dash_counter_t eCounter, uint16_t uiValue);
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#endif /* __DASH_H__ */
@@ -0,0 +1,148 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: dnscache.h                                                         |
+| project:  ZX Spectrum Next - PING                                            |
+| author:   Stefan Zell                                                        |
+| date:     16/10/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Persistent cache of resolved hostnames on the SD card                        |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 16/10/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+#if !defined(__DNSCACHE_H__)
+  #define __DNSCACHE_H__
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+Name of the cache file
+*/
+#define sDNSCACHE_FILE "/tmp/ping.dns"
+
+/*!
+Number of entries of the cache file
+*/
+#define uiDNSCACHE_ENTRIES (8)
+
+/*!
+Maximum length of a hostname stored in the cache (longer names are not
+cached)
+*/
+#define uiDNSCACHE_NAME (48)
+
+/*!
+Maximum length of an IP address ("255.255.255.255")
+*/
+#define uiDNSCACHE_ADDR (16)
+
+/*!
+Time to live of an entry [min]; "AT+CIPDOMAIN" does not return the TTL of the
+DNS record, so all entries expire after this time
+*/
+#define uiDNSCACHE_TTL (60)
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+/*!
+Entry of the cache file
+*/
+typedef struct _dnscache_entry
+{
+  /*!
+  Hostname; empty if the entry is not used
+  */
+  char acName[uiDNSCACHE_NAME];
+
+  /*!
+  IP address of the host
+  */
+  char acAddr[uiDNSCACHE_ADDR];
+
+  /*!
+  End of the lifetime of the entry [min] (see "dnscache_lookup")
+  */
+  uint32_t uiExpires;
+} dnscache_entry_t;
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+/*!
+Search a hostname in the cache file. Without RTC the age of the entries is
+unknown, so the cache is not used at all.
+@param acName Hostname
+@param acAddr Buffer for the IP address (uiDNSCACHE_ADDR bytes)
+@return "true" if a valid entry was found
+*/
+bool dnscache_lookup(const char* acName, char* acAddr);
+
+/*!
+Store the IP address of a hostname in the cache file; the entry of the same
+name, an expired or the oldest entry is replaced.
+@param acName Hostname
+@param acAddr IP address of the host
+@return EOK or errorcode of esxDOS
+*/
+int dnscache_store(const char* acName, const char* acAddr);
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#endif /* __DNSCACHE_H__ */
@@ -0,0 +1,133 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: espcap.h                                                           |
+| project:  ZX Spectrum Next - PING                                            |
+| author:   Stefan Zell                                                        |
+| date:     16/10/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Capture of all bytes sent to and received from the ESP8266 ("-C file")       |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 16/10/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+#if !defined(__ESPCAP_H__)
+  #define __ESPCAP_H__
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+Size of the write buffer (one sector of the SD card)
+*/
+#define uiESPCAP_BUFFER_SIZE (0x200)
+
+/*!
+Maximum number of received bytes collected in one record; a record also ends
+with each line feed
+*/
+#define uiESPCAP_CHUNK_SIZE (0x40)
+
+/*!
+Size of the header of a record: time [100 us] (4 bytes, little endian),
+direction (1 byte), number of data bytes (1 byte)
+*/
+#define uiESPCAP_HEADER_SIZE (6)
+
+/*!
+Direction of a record
+*/
+#define uiESPCAP_DIR_TX (0x00) /* sent to the ESP8266                     */
+#define uiESPCAP_DIR_RX (0x01) /* received from the ESP8266               */
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+/*!
+Create the capture file; an existing file is overwritten. The file is a
+sequence of records (header of uiESPCAP_HEADER_SIZE bytes followed by the
+data bytes), the time is counted from the start of the capture.
+@param acFile Name of the capture file
+@return EOK or errorcode of esxDOS
+*/
+int espcap_open(const char* acFile);
+
+/*!
+Record a command sent to the ESP8266
+@param acCmd Command (including CR/LF)
+*/
+void espcap_tx(const char* acCmd);
+
+/*!
+Record a byte received from the ESP8266
+@param uiByte Received byte
+*/
+void espcap_rx(uint8_t uiByte);
+
+/*!
+Write all pending records and close the capture file (if open)
+@return EOK or errorcode of esxDOS
+*/
+int espcap_close(void);
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#endif /* __ESPCAP_H__ */
@@ -0,0 +1,123 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: espready.h                                                         |
+| project:  ZX Spectrum Next - PING                                            |
+| author:   Stefan Zell                                                        |
+| date:     16/10/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Readiness record of the ESP8266 (state left by the last run)                 |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 16/10/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+#if !defined(__ESPREADY_H__)
+  #define __ESPREADY_H__
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+Name of the file of the readiness record
+*/
+#define sESPREADY_FILE "/tmp/ping.esp"
+
+/*!
+Flags of "espready_t::uiFlags"
+*/
+#define uiESPREADY_IDLE (0x01) /* no response of the ESP8266 pending      */
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+/*!
+Known-good state of the UART and the ESP8266 at the end of the last run
+*/
+typedef struct _espready
+{
+  /*!
+  Baudrate of the UART and the ESP8266 [bit/s]
+  */
+  uint32_t uiBaud;
+
+  /*!
+  State of the ESP8266 (uiESPREADY_xxx)
+  */
+  uint8_t uiFlags;
+} espready_t;
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+/*!
+Read the readiness record left by the last run
+@param pReady Buffer for the record
+@return "true" if a valid record was read
+*/
+bool espready_load(espready_t* pReady);
+
+/*!
+Store the readiness record for the next run; the file is written only if the
+record differs from the one read by "espready_load"
+@param pReady Record to store
+@return EOK or errorcode of esxDOS
+*/
+int espready_store(const espready_t* pReady);
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#endif /* __ESPREADY_H__ */
@@ -0,0 +1,139 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: esprx.h                                                            |
+| project:  ZX Spectrum Next - PING                                            |
+| author:   Stefan Zell                                                        |
+| date:     16/10/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Interrupt driven receive path of the ESP8266 UART                            |
+|                                                                              |
+| All bytes received from the ESP8266 are moved by an IM2 interrupt (hardware  |
+| IM2 mode of the Next, UART0 "RX available") into a ring buffer, so that no   |
+| byte is lost while the program prints, scans the keyboard or sleeps.         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 16/10/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+#if !defined(__ESPRX_H__)
+  #define __ESPRX_H__
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+Size of the receive ring buffer (power of two, max. 256)
+*/
+#define uiESPRX_RING_SIZE (0x100)
+
+/*!
+Mask for the indices of the receive ring buffer
+*/
+#define uiESPRX_RING_MASK (uiESPRX_RING_SIZE - 1)
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+/*!
+Statistical information of the receive ring buffer
+*/
+typedef struct _esprx_stats
+{
+  /*!
+  Maximum number of bytes that were pending in the ring buffer
+  */
+  uint16_t uiHighWater;
+
+  /*!
+  Number of bytes lost because the ring buffer was full
+  */
+  uint16_t uiOverruns;
+} esprx_stats_t;
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+/*!
+Install the interrupt service routine and enable the receive interrupt of
+the ESP8266 UART ("esp_open" must have been called before)
+*/
+void esprx_init(void);
+
+/*!
+Disable the receive interrupt and restore the interrupt mode of NextOS
+*/
+void esprx_exit(void);
+
+/*!
+Discard all bytes pending in the ring buffer
+*/
+void esprx_flush(void);
+
+/*!
+Read the next byte received from the ESP8266 without waiting
+@return Received byte; negative, if no byte is available
+*/
+int esprx_getc(void);
+
+/*!
+Returns the statistical information of the receive ring buffer
+*/
+const esprx_stats_t* esprx_stats(void);
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#endif /* __ESPRX_H__ */
@@ -0,0 +1,118 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: fmt.h                                                              |
+| project:  ZX Spectrum Next - PING                                            |
+| author:   Stefan Zell                                                        |
+| date:     16/10/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Minimal formatter for the output of the application                          |
+|                                                                              |
+| Replaces the printf engine of the C library for the few conversions used by  |
+| the application: %s %c %d %u %lu %% with optional width and flag '0'.        |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 16/10/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+#if !defined(__FMT_H__)
+  #define __FMT_H__
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <stdio.h>
+#include <stdarg.h>
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+Size of the buffer used to write to a stream; longer output is written in
+several parts
+*/
+#define uiFMT_STREAM_BUFFER (0x40)
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+/*!
+Format a string into a buffer (like "vsnprintf"); the result is truncated to
+the size of the buffer and always terminated.
+@param acBuffer Buffer
+@param uiSize Size of the buffer
+@param acFmt Format string
+@param args Arguments
+@return Length of the complete result (without terminating zero)
+*/
+uint16_t fmt_vformat(char* acBuffer, uint16_t uiSize, const char* acFmt, va_list args);
+
+/*!
+Format a string into a buffer (like "snprintf", see "fmt_vformat")
+*/
+uint16_t fmt_format(char* acBuffer, uint16_t uiSize, const char* acFmt, ...);
+
+/*!
+Format a string and write it to a stream (like "vfprintf")
+@param pStream Stream ("stdout", "stderr")
+@param acFmt Format string
+@param args Arguments
+@return Number of characters written
+*/
+uint16_t fmt_vprint(FILE* pStream, const char* acFmt, va_list args);
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#endif /* __FMT_H__ */
@@ -0,0 +1,164 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: histo.h                                                            |
+| project:  ZX Spectrum Next - PING                                            |
+| author:   Stefan Zell                                                        |
+| date:     16/10/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Streaming latency histogram with logarithmic buckets                         |
+|                                                                              |
+| Values below 16 have a bucket each, every following power of two is split    |
+| into 8 buckets (resolution 12.5 %). Memory is constant, adding a value is    |
+| O(1) and no floating point arithmetic is used.                               |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 16/10/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+#if !defined(__HISTO_H__)
+  #define __HISTO_H__
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+Number of values with a bucket of their own (0 .. 15)
+*/
+#define uiHISTO_LINEAR (0x10)
+
+/*!
+Number of buckets per power of two (above the linear range)
+*/
+#define uiHISTO_SUB (0x08)
+
+/*!
+Total number of buckets for 16 bit values: 16 + 12 powers of two * 8
+*/
+#define uiHISTO_BUCKETS (uiHISTO_LINEAR + (12 * uiHISTO_SUB))
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+/*!
+Histogram of 16 bit values (e.g. round trip times in [ms])
+*/
+typedef struct _histo
+{
+  /*!
+  Number of values per bucket
+  */
+  uint16_t auiBucket[uiHISTO_BUCKETS];
+
+  /*!
+  Number of values in the histogram
+  */
+  uint16_t uiCount;
+
+  /*!
+  Sum of all values
+  */
+  uint32_t uiSum;
+
+  /*!
+  Sum of the squares of all values (48 bit: uiSum2Hi:uiSum2Lo)
+  */
+  uint32_t uiSum2Lo;
+  uint16_t uiSum2Hi;
+
+  /*!
+  Smallest and largest value added (the percentiles are limited to them)
+  */
+  uint16_t uiMin;
+  uint16_t uiMax;
+} histo_t;
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+/*!
+Remove all values from the histogram
+@param pHisto Histogram
+*/
+void histo_reset(histo_t* pHisto);
+
+/*!
+Add a value to the histogram. If the counters are going to overflow, all
+buckets and sums are halved, so that the distribution is kept.
+@param pHisto Histogram
+@param uiValue Value
+*/
+void histo_add(histo_t* pHisto, uint16_t uiValue);
+
+/*!
+Returns the value below which the given percentage of all values lies (the
+upper bound of the bucket that contains the percentile, but never outside the
+smallest and largest value added)
+@param pHisto Histogram
+@param uiPercent Percentile (0 .. 100)
+*/
+uint16_t histo_percentile(const histo_t* pHisto, uint8_t uiPercent);
+
+/*!
+Returns the mean deviation (standard deviation as printed by Linux "ping")
+of all values
+@param pHisto Histogram
+*/
+uint16_t histo_mdev(const histo_t* pHisto);
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#endif /* __HISTO_H__ */
@@ -0,0 +1,175 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: monitor.h                                                          |
+| project:  ZX Spectrum Next - PING                                            |
+| author:   Stefan Zell                                                        |
+| date:     16/10/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Resident background monitor                                                  |
+|                                                                              |
+| Interface to the NextZXOS driver "pingmon.drv" (see "drv/pingmon.asm"), which|
+| pings one IP address on each interrupt while NextBASIC runs and publishes    |
+| its statistics in a shared memory block at a fixed address. BASIC programs   |
+| read the block with PEEK/DPEEK; the block has to be above RAMTOP             |
+| (CLEAR 49119).                                                               |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 16/10/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+#if !defined(__MONITOR_H__)
+  #define __MONITOR_H__
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+Id of the driver (BASIC: DRIVER 112,...); the values of this file have to
+match "drv/pingmon.inc"
+*/
+#define uiMONITOR_DRIVER_ID (0x70)
+
+/*!
+Address of the shared memory block (49120 .. 49151)
+*/
+#define uiMONITOR_BLOCK (0xBFE0)
+
+/*!
+Duration of a frame, the time base of the driver [ms]
+*/
+#define uiMONITOR_FRAME_MS (20)
+
+/*!
+Maximum length of the command of the driver ("AT+PING=...\r\n")
+*/
+#define uiMONITOR_CMD_SIZE (28)
+
+/*!
+Calls of the driver API (B = call id)
+*/
+#define uiMONITOR_CALL_START    (0x01) /* HL = command                     */
+#define uiMONITOR_CALL_INTERVAL (0x02) /* DE = interval [frames]           */
+#define uiMONITOR_CALL_STOP     (0x03)
+#define uiMONITOR_CALL_PAUSE    (0x04) /* E = 0: resume, else pause        */
+
+/*!
+States of the driver (monitor_block_t::uiState)
+*/
+#define uiMONITOR_STATE_STOPPED (0x00)
+#define uiMONITOR_STATE_IDLE    (0x01) /* waiting for the next probe        */
+#define uiMONITOR_STATE_WAIT    (0x02) /* waiting for the response          */
+#define uiMONITOR_STATE_PAUSED  (0x80) /* flag: an application uses the ESP */
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+/*!
+Shared memory block of the driver; all values are little endian, the offsets
+are the same for BASIC (e.g. DPEEK 49124 = probes sent)
+*/
+typedef struct _monitor_block
+{
+  char     acSignature[2]; /* +0  "PM", written on start                    */
+  uint8_t  uiState;        /* +2  uiMONITOR_STATE_xxx                       */
+  uint8_t  uiResult;       /* +3  last probe (uiRECLOG_RESULT_xxx)          */
+  uint16_t uiSent;         /* +4  probes sent                               */
+  uint16_t uiReceived;     /* +6  responses received                        */
+  uint16_t uiRtt;          /* +8  last RTT [ms]                             */
+  uint16_t uiMin;          /* +10 min. RTT [ms]                             */
+  uint16_t uiMax;          /* +12 max. RTT [ms]                             */
+  uint16_t uiAvg;          /* +14 rolling avg. RTT [ms], weight 1/8         */
+  uint16_t uiStreak;       /* +16 probes lost in a row                      */
+  uint8_t  auiAddr[4];     /* +18 IP address a.b.c.d                        */
+} monitor_block_t;
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+/*!
+Pause or resume the driver; while an application of the ESP8266 runs, the
+driver has to be paused
+@param bPause true = pause, false = resume
+@return "true" = the driver is installed
+*/
+bool monitor_pause(bool bPause);
+
+/*!
+Start to ping in the background; the statistics of the block are reset
+@param acCmd Command to send ("AT+PING=...\r\n"); it has to be located in
+             main memory (0x4000 .. 0xFFFF), the memory of the dot command
+             is not visible to the driver
+@param uiAddr IP address (published in the block)
+@param uiInterval Interval between the probes [ms]
+@return EOK = the driver is running
+*/
+int monitor_start(const char* acCmd, uint32_t uiAddr, uint16_t uiInterval);
+
+/*!
+Stop the driver and remove it from NextZXOS
+@return EOK = the driver is removed
+*/
+int monitor_uninstall(void);
+
+/*!
+Shared memory block of the driver
+@return Pointer to the block; only valid if "acSignature" is "PM"
+*/
+const monitor_block_t* monitor_block(void);
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#endif /* __MONITOR_H__ */
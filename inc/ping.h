@@ -49,6 +49,11 @@ Maximum length of the hostname
 */
 #define uiMAX_HOST_NAME (0x100)
 
+/*!
+Maximum length of the name of the log file
+*/
+#define uiMAX_FILE_NAME (0x40)
+
 /*!
 Maximum length of a AT command to ESP8266
 */
@@ -59,6 +64,21 @@ ESP command to send a PING request
 */
 #define sCMD_AT_PING "AT+PING"
 
+/*!
+ESP command to check the connection
+*/
+#define sCMD_AT "AT"
+
+/*!
+ESP command to set the baudrate (not stored in flash)
+*/
+#define sCMD_AT_UART_CUR "AT+UART_CUR"
+
+/*!
+ESP command to resolve a hostname
+*/
+#define sCMD_AT_CIPDOMAIN "AT+CIPDOMAIN"
+
 /*!
 ESP command to read version information
 */
@@ -74,6 +94,51 @@ ESP command to set/get local IP addresses
 */
 #define sCMD_AT_CIPSTA_CUR "AT+CIPSTA_CUR"
 
+/*!
+Commands of the UDP echo probes ("-u")
+*/
+#define sCMD_AT_CIPMUX   "AT+CIPMUX"
+#define sCMD_AT_CIPSTART "AT+CIPSTART"
+#define sCMD_AT_CIPSEND  "AT+CIPSEND"
+#define sCMD_AT_CIPCLOSE "AT+CIPCLOSE"
+
+/*!
+Command of the passthrough mode of the throughput test ("-R")
+*/
+#define sCMD_AT_CIPMODE "AT+CIPMODE"
+
+/*!
+Maximum time to wait for the complete response of the ESP8266 [ms]
+*/
+#define uiESP_RX_TIMEOUT (5000)
+
+/*!
+Maximum time to wait for the response to the quick "AT" at startup [ms]
+*/
+#define uiESP_PROBE_TIMEOUT (100)
+
+/*!
+Time the ESP8266 needs to switch to a new baudrate [ms]
+*/
+#define uiESP_BAUD_SETTLE (20)
+
+/*!
+Number of pings between two checks of the keyboard in flood mode (power of
+two)
+*/
+#define uiFLOOD_KEY_CHECK (0x10)
+
+/*!
+Interval of the keyboard checks while waiting for the ESP8266 or for the next
+ping [ms]
+*/
+#define uiKEY_POLL (5)
+
+/*!
+Result of "receivePing" if the user interrupted the wait (not logged)
+*/
+#define uiPING_RESULT_BREAK (0xFE)
+
 /*!
 Default value for number of ping
 */
@@ -84,6 +149,70 @@ Default value for interval between pings [ms]
 */
 #define uiDEFAULT_INTERVAL (100)
 
+/*!
+Default number of connections (probes in flight) of the UDP echo ("-n")
+*/
+#define uiDEFAULT_LINKS (4)
+
+/*!
+Time to wait for the reply to a UDP echo probe, if "-W" is not given [ms]
+*/
+#define uiECHO_TIMEOUT (1000)
+
+/*!
+Local port of the first connection of the UDP echo (one port per link)
+*/
+#define uiECHO_LOCAL_PORT (4000)
+
+/*!
+Default size of the chunks of the throughput test [bytes] ("-s")
+*/
+#define uiDEFAULT_CHUNK (1024)
+
+/*!
+Maximum size of a chunk ("AT+CIPSEND" accepts up to 2048 bytes)
+*/
+#define uiMAX_CHUNK (2048)
+
+/*!
+Default duration of the throughput test, if "-T" and "-k" are not given [s]
+*/
+#define uiDEFAULT_TEST_TIME (10)
+
+/*!
+Maximum duration of the throughput test [s]; also ends a test of "-k"
+*/
+#define uiMAX_TEST_TIME (3600)
+
+/*!
+Silence on the UART before and after "+++", that ends the passthrough mode
+(the ESP8266 needs 20 ms before and 1 s after) [ms]
+*/
+#define uiPASSTHROUGH_GAP   (20)
+#define uiPASSTHROUGH_GUARD (1000)
+
+/*!
+Value of "uiExportVar" if no integer variables are set ("-X")
+*/
+#define uiEXPORT_NO_VAR (0xFF)
+
+/*!
+Percentile of the RTT checked by "-P"
+*/
+#define uiSLO_PERCENTILE (95)
+
+/*!
+Value of "uiMaxLoss" if no loss threshold is given
+*/
+#define uiSLO_OFF (0xFF)
+
+/*!
+Exitcodes if a threshold of the service level is violated ("-L", "-A", "-P")
+*/
+#define ESLO_LOSS (0x70) /* loss above "-L"                               */
+#define ESLO_AVG  (0x71) /* average RTT above "-A"                        */
+#define ESLO_P95  (0x72) /* 95th percentile of the RTT above "-P"         */
+
 /*============================================================================*/
 /*                               Namespaces                                   */
 /*============================================================================*/
@@ -112,9 +241,73 @@ typedef enum _action
   ACTION_HELP,
   ACTION_INFO,
   ACTION_INFOEX,
-  ACTION_PING
+  ACTION_PING,
+  ACTION_SWEEP,
+  ACTION_BATCH,
+  ACTION_ECHO,
+  ACTION_THROUGHPUT,
+  ACTION_MONITOR,
+  ACTION_MONSTAT,
+  ACTION_UNINSTALL
 } action_t;
 
+/*!
+Timestamps taken during a ping
+*/
+typedef enum _stamp
+{
+  STAMP_TX_START = 0, /* before the command is sent to the ESP8266      */
+  STAMP_TX_DONE,      /* command is completely written to the UART      */
+  STAMP_RX_FIRST,     /* first byte of the response is received         */
+  STAMP_RX_DONE,      /* final line ("OK", "FAIL", ...) is received     */
+  STAMP_LOCAL_DONE,   /* statistics, output and log of the ping are done */
+  STAMP_COUNT
+} stamp_t;
+
+/*!
+Phases of a ping calculated from the timestamps
+*/
+typedef enum _phase
+{
+  PHASE_UART_TX = 0,  /* STAMP_TX_START .. STAMP_TX_DONE                */
+  PHASE_ESP,          /* STAMP_TX_DONE .. STAMP_RX_FIRST minus network  */
+  PHASE_NETWORK,      /* RTT reported by the ESP8266                    */
+  PHASE_UART_RX,      /* STAMP_RX_FIRST .. STAMP_RX_DONE                */
+  PHASE_LOCAL,        /* STAMP_RX_DONE .. STAMP_LOCAL_DONE              */
+  PHASE_COUNT
+} phase_t;
+
+/*!
+Statistical information of a phase [ticks]
+*/
+typedef struct _phasestats
+{
+  uint32_t uiTotal;
+  uint16_t uiMin;
+  uint16_t uiMax;
+} phasestats_t;
+
+/*!
+Probe of a connection of the UDP echo ("-u")
+*/
+typedef struct _echolink
+{
+  /*!
+  If this flag is set, the probe waits for its reply
+  */
+  bool bBusy;
+
+  /*!
+  Sequence number of the probe
+  */
+  uint16_t uiSeq;
+
+  /*!
+  Transmission of the probe to the ESP8266 [ticks]
+  */
+  uint32_t uiStamp;
+} echolink_t;
+
 /*!
 In dieser Struktur werden alle globalen Daten der Anwendung gespeichert.
 */
@@ -146,9 +339,154 @@ typedef struct _appstate
   uint16_t uiInterval;
 
   /*!
-  Name of the host to ping
+  If this flag is set, the interval is measured from the start of one ping to
+  the start of the next ping (fixed probe rate)
+  */
+  bool bFixedRate;
+
+  /*!
+  If this flag is set, pings are sent as fast as possible without output per
+  ping (flood mode, "-F")
   */
-  char_t acHost[uiMAX_HOST_NAME];
+  bool bFlood;
+
+  /*!
+  If this flag is set, a live latency graph is shown instead of one line per
+  ping (dashboard, "-d")
+  */
+  bool bDashboard;
+
+  /*!
+  Maximum time to wait for the response to a ping [ms] ("-W"); 0 = until the
+  ESP8266 reports the timeout
+  */
+  uint16_t uiDeadline;
+
+  /*!
+  Thresholds of the service level: maximum loss [%] ("-L", uiSLO_OFF = none),
+  maximum average and 95th percentile of the RTT [ms] ("-A", "-P", 0 = none)
+  */
+  uint8_t  uiMaxLoss;
+  uint16_t uiMaxAvg;
+  uint16_t uiMaxP95;
+
+  /*!
+  If this flag is set, pinging stops as soon as a threshold is certainly
+  violated, whatever the remaining pings return ("-E")
+  */
+  bool bEarlyExit;
+
+  /*!
+  Port of the UDP echo service ("-u"); 0 = ping by "AT+PING"
+  */
+  uint16_t uiEchoPort;
+
+  /*!
+  Number of connections, i.e. UDP echo probes in flight ("-n")
+  */
+  uint8_t uiLinks;
+
+  /*!
+  Port of the TCP service ("-p"); each ping is a connect to this port
+  instead of "AT+PING", 0 = ICMP
+  */
+  uint16_t uiTcpPort;
+
+  /*!
+  Throughput test ("-t"): port of the TCP sink, size of the chunks [bytes]
+  ("-s"), duration [s] ("-T") and amount of data [KB] ("-k", 0 = no limit);
+  the test ends with the first limit reached
+  */
+  uint16_t uiTestPort;
+  uint16_t uiChunk;
+  uint16_t uiTestTime;
+  uint16_t uiTestKb;
+
+  /*!
+  If this flag is set, the throughput test uses the passthrough mode of the
+  ESP8266 ("AT+CIPMODE=1") instead of one "AT+CIPSEND" per chunk ("-R")
+  */
+  bool bPassthrough;
+
+  /*!
+  If this flag is set, the final statistics are written to memory at exit:
+  to "uiExportAddr" in main memory, or to this offset of the 16K bank
+  "uiExportBank" ("-x addr", "-x bank,offset")
+  */
+  bool bExport;
+  uint8_t uiExportBank;
+  uint16_t uiExportAddr;
+
+  /*!
+  First NextBASIC integer variable the final statistics are written to ("-X",
+  0 = %a); uiEXPORT_NO_VAR = none
+  */
+  uint8_t uiExportVar;
+
+  /*!
+  If this flag is set, the ESP8266 still processes a ping that passed its
+  deadline; its response has to be read before the next command is sent
+  */
+  bool bPending;
+
+  /*!
+  If this flag is set, the driver of the resident monitor is installed; it is
+  paused while the application uses the ESP8266 ("-M", "-m", "-U")
+  */
+  bool bMonitor;
+
+  /*!
+  If this flag is set, the UART and the ESP8266 are initialized; this is done
+  only for actions that use the ESP8266 (see "openEsp")
+  */
+  bool bEspOpen;
+
+  /*!
+  If this flag is set, the ESP8266 answered the quick "AT" at startup, so the
+  flush of the UART was skipped
+  */
+  bool bEspReady;
+
+  /*!
+  Maximum time "readLine" waits for a line of the ESP8266 [ms]
+  */
+  uint16_t uiRxTimeout;
+
+  /*!
+  Start of the application [ticks]
+  */
+  uint32_t uiLaunch;
+
+  /*!
+  Baudrate of the ESP8266 while pinging [bit/s] ("-b")
+  */
+  uint32_t uiBaud;
+
+  /*!
+  Name of the host to ping (uiMAX_HOST_NAME bytes, see "bankmem.h")
+  */
+  char_t* acHost;
+
+  /*!
+  IP address of the host (resolved once before the first ping); empty if the
+  ESP8266 has to resolve the hostname itself
+  */
+  char_t acAddr[uiDNSCACHE_ADDR];
+
+  /*!
+  Name of the file the results of all pings are logged to ("-o")
+  */
+  char_t acLogFile[uiMAX_FILE_NAME];
+
+  /*!
+  Name of the file with the list of hosts of the batch mode ("-f")
+  */
+  char_t acListFile[uiMAX_FILE_NAME];
+
+  /*!
+  Name of the file all bytes on the UART of the ESP8266 are captured to ("-C")
+  */
+  char_t acCapFile[uiMAX_FILE_NAME];
 
   /*!
   Backup: Current speed of Z80N
@@ -165,6 +503,21 @@ typedef struct _appstate
   */
   struct
   {
+    /*!
+    Duration of the resolution of the hostname [ms]
+    */
+    uint16_t uiResolve;
+
+    /*!
+    Time from the start of the application to the first ping [ms]
+    */
+    uint16_t uiStartup;
+
+    /*!
+    If this flag is set, the hostname was found in the cache file
+    */
+    bool bCached;
+
     /*!
     Sum of the duration of all pings
     */
@@ -194,6 +547,36 @@ typedef struct _appstate
     Number of successful responses
     */
     uint16_t uiPongs;
+
+    /*!
+    Number of pings that started after their slot (fixed probe rate)
+    */
+    uint16_t uiLate;
+
+    /*!
+    Number of slots without a ping, because a ping overran (fixed probe rate)
+    */
+    uint16_t uiSkipped;
+
+    /*!
+    Number of pings slower than the threshold of the 95th percentile ("-P")
+    */
+    uint16_t uiSlow;
+
+    /*!
+    Distribution of the durations of all successful pings
+    */
+    histo_t tHisto;
+
+    /*!
+    Timestamps of the current ping [ticks]
+    */
+    uint32_t auiStamp[STAMP_COUNT];
+
+    /*!
+    Duration of the phases of all successful pings
+    */
+    phasestats_t atPhase[PHASE_COUNT];
   } stats;
 
   /*!
@@ -201,17 +584,22 @@ typedef struct _appstate
   */
   esp_t tEsp;
 
+  /*!
+  Parser for the responses of the ESP8266
+  */
+  at_parser_t tParser;
+
   struct
   {
     /*!
-    Buffer for response from ESP8266
+    Buffer for commands to ESP8266 (uiMAX_LEN_CMD bytes, see "bankmem.h")
     */
-    char_t acTxBuffer[uiMAX_LEN_CMD];
+    char_t* acTxBuffer;
 
     /*!
-    Buffer for response from ESP8266
+    Buffer for response from ESP8266 (uiMAX_LEN_CMD bytes, see "bankmem.h")
     */
-    char_t acRxBuffer[uiMAX_LEN_CMD];
+    char_t* acRxBuffer;
   } esp;
   
   /*!
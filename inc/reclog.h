@@ -0,0 +1,151 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: reclog.h                                                           |
+| project:  ZX Spectrum Next - PING                                            |
+| author:   Stefan Zell                                                        |
+| date:     16/10/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Binary log of the results of all pings ("-o file")                           |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 16/10/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+#if !defined(__RECLOG_H__)
+  #define __RECLOG_H__
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+Size of the write buffer (one sector of the SD card)
+*/
+#define uiRECLOG_BUFFER_SIZE (0x200)
+
+/*!
+Results of a ping stored in "reclog_record_t::uiResult"
+*/
+#define uiRECLOG_RESULT_OK      (0x00) /* response received                 */
+#define uiRECLOG_RESULT_TIMEOUT (0x01) /* no response from the remote host  */
+#define uiRECLOG_RESULT_BUSY    (0x02) /* ESP8266 dropped the request       */
+#define uiRECLOG_RESULT_ERROR   (0x03) /* host unknown                      */
+#define uiRECLOG_RESULT_COMM    (0x04) /* no response from the ESP8266      */
+#define uiRECLOG_RESULT_START   (0xFF) /* first record of a run             */
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+/*!
+Record of the log file (8 bytes, little endian, 64 records per sector). Each
+run starts with a record "uiRECLOG_RESULT_START" that holds the interval
+[ms] in "uiRtt" and the options of the run in "uiSeq" (bit 0: "-r").
+*/
+typedef struct _reclog_record
+{
+  /*!
+  Time since the start of the run [100 us]
+  */
+  uint32_t uiTime;
+
+  /*!
+  Duration of the ping [ms]
+  */
+  uint16_t uiRtt;
+
+  /*!
+  Sequence number of the ping (lower 8 bits)
+  */
+  uint8_t uiSeq;
+
+  /*!
+  Result of the ping (uiRECLOG_RESULT_xxx)
+  */
+  uint8_t uiResult;
+} reclog_record_t;
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+/*!
+Open the log file and append the start record of a new run; the file is
+created if it does not exist.
+@param acFile Name of the log file
+@param uiInterval Interval between pings [ms]
+@param bFixedRate Option "-r"
+@return EOK or errorcode of esxDOS
+*/
+int reclog_open(const char* acFile, uint16_t uiInterval, bool bFixedRate);
+
+/*!
+Append the result of a ping to the log; the records are collected in a
+buffer that is written to the file when it is full.
+@param uiSeq Sequence number of the ping
+@param uiRtt Duration of the ping [ms]
+@param uiResult Result of the ping (uiRECLOG_RESULT_xxx)
+@return EOK or errorcode of esxDOS
+*/
+int reclog_add(uint16_t uiSeq, uint16_t uiRtt, uint8_t uiResult);
+
+/*!
+Write all pending records and close the log file (if open)
+@return EOK or errorcode of esxDOS
+*/
+int reclog_close(void);
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#endif /* __RECLOG_H__ */
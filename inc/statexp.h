@@ -0,0 +1,145 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: statexp.h                                                          |
+| project:  ZX Spectrum Next - PING                                            |
+| author:   Stefan Zell                                                        |
+| date:     16/10/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Export of the statistics to memory and integer variables of NextBASIC        |
+| ("-x", "-X")                                                                 |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 16/10/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+#if !defined(__STATEXP_H__)
+  #define __STATEXP_H__
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+Bank of "statexp_write" if the address is in main memory (0x4000 .. 0xFFFF)
+*/
+#define uiSTATEXP_NO_BANK (0xFF)
+
+/*!
+Last 16K bank of "statexp_write": pages 222/223, the end of the RAM of a 2 MB
+Next; the 8K page of higher banks does not fit into the MMU register
+*/
+#define uiSTATEXP_MAX_BANK (111)
+
+/*!
+Flags of the block (statexp_t::uiFlags)
+*/
+#define uiSTATEXP_FLAG_TENTHS      (0x01) /* RTTs in [0.1 ms] ("-u")          */
+#define uiSTATEXP_FLAG_PERCENTILES (0x02) /* p50/p90/p99 and mdev are valid   */
+
+/*!
+Number of integer variables set by "statexp_basic" (result, sent, received,
+loss, min, avg, max)
+*/
+#define uiSTATEXP_VARS (7)
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+/*!
+Block with the final statistics; all values are little endian, the offsets
+are the same for BASIC (e.g. DPEEK addr+6 = responses received)
+*/
+typedef struct _statexp
+{
+  char     acSignature[2]; /* +0  "PS"                                      */
+  uint8_t  uiResult;       /* +2  exit code of the dot command (0 = ok)     */
+  uint8_t  uiFlags;        /* +3  uiSTATEXP_FLAG_xxx                        */
+  uint16_t uiSent;         /* +4  pings sent                                */
+  uint16_t uiReceived;     /* +6  responses received                        */
+  uint16_t uiLoss;         /* +8  loss [%]                                  */
+  uint16_t uiMin;          /* +10 min. RTT [ms]                             */
+  uint16_t uiAvg;          /* +12 avg. RTT [ms]                             */
+  uint16_t uiMax;          /* +14 max. RTT [ms]                             */
+  uint16_t uiP50;          /* +16 median of the RTT [ms]                    */
+  uint16_t uiP90;          /* +18 90th percentile of the RTT [ms]           */
+  uint16_t uiP99;          /* +20 99th percentile of the RTT [ms]           */
+  uint16_t uiMdev;         /* +22 mean deviation of the RTT [ms]            */
+} statexp_t;
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+/*!
+Copy the block to memory that BASIC can read
+@param pBlock Block
+@param uiBank 16K bank of NextBASIC ("BANK n PEEK offset"); uiSTATEXP_NO_BANK
+       for an address in main memory
+@param uiAddr Offset in the bank, or address in main memory
+*/
+void statexp_write(const statexp_t* pBlock, uint8_t uiBank, uint16_t uiAddr);
+
+/*!
+Set uiSTATEXP_VARS integer variables of NextBASIC ("IDE_INTEGER_VAR"),
+starting at the given one: result, sent, received, loss, min, avg, max
+@param pBlock Block
+@param uiVar First variable (0 = %a, ..., 25 = %z)
+@return "true" if all variables are set
+*/
+bool statexp_basic(const statexp_t* pBlock, uint8_t uiVar);
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#endif /* __STATEXP_H__ */
@@ -0,0 +1,148 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: timer.h                                                            |
+| project:  ZX Spectrum Next - PING                                            |
+| author:   Stefan Zell                                                        |
+| date:     16/10/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Hardware time base of the application (CTC channels 0-4)                     |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 16/10/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+#if !defined(__TIMER_H__)
+  #define __TIMER_H__
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+Nominal resolution of the time base: number of ticks per millisecond
+(one tick = 100 us at exactly 10 kHz)
+*/
+#define uiTIMER_TICKS_PER_MS (10)
+
+/*!
+Convert milliseconds into ticks of the time base
+*/
+#define TIMER_MS_TO_TICKS(ms) timer_from_ms((uint32_t) (ms))
+
+/*!
+Convert ticks of the time base into units of 100 us
+*/
+#define TIMER_TICKS_TO_100US(t) timer_to_100us((uint32_t) (t))
+
+/*!
+Convert ticks of the time base into milliseconds
+*/
+#define TIMER_TICKS_TO_MS(t) (timer_to_100us((uint32_t) (t)) / uiTIMER_TICKS_PER_MS)
+
+/*!
+Returns "true", if timestamp "a" is before timestamp "b" (wrap around safe)
+*/
+#define TIMER_BEFORE(a, b) (((int32_t) ((a) - (b))) < 0)
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+/*!
+Start the time base.
+CTC channel 0 divides the system clock of the current video timing down to
+about 10 kHz, channels 1-4 are chained as counters (ZC/TO of channel n is the
+trigger of channel n+1) and form a free running 32 bit counter of ticks.
+The remaining deviation from 10 kHz is corrected by the conversions.
+*/
+void timer_init(void);
+
+/*!
+Stop the time base and release the CTC channels
+*/
+void timer_exit(void);
+
+/*!
+Returns the current timestamp [ticks]
+*/
+uint32_t timer_now(void);
+
+/*!
+Convert milliseconds into ticks ("TIMER_MS_TO_TICKS")
+@param uiMs Milliseconds
+@return Ticks of the time base
+*/
+uint32_t timer_from_ms(uint32_t uiMs);
+
+/*!
+Convert ticks into units of 100 us ("TIMER_TICKS_TO_100US")
+@param uiTicks Ticks of the time base
+@return Time [100 us]
+*/
+uint32_t timer_to_100us(uint32_t uiTicks);
+
+/*!
+Busy wait until the given timestamp is reached
+@param uiDeadline Timestamp [ticks]
+*/
+void timer_wait_until(uint32_t uiDeadline);
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#endif /* __TIMER_H__ */
@@ -0,0 +1,170 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: udpecho.h                                                          |
+| project:  ZX Spectrum Next - PING                                            |
+| author:   Stefan Zell                                                        |
+| date:     16/10/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Parser of the responses of the ESP8266 in multi-connection mode              |
+| (UDP echo probes, "-u port")                                                 |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 16/10/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+#if !defined(__UDPECHO_H__)
+  #define __UDPECHO_H__
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+Maximum number of connections of the ESP8266 ("AT+CIPMUX=1")
+*/
+#define uiUDPECHO_LINKS (5)
+
+/*!
+Length of a probe: 'P' and the sequence number (5 digits)
+*/
+#define uiUDPECHO_PROBE_LEN (6)
+
+/*!
+Number of characters of a line kept for the classification
+*/
+#define uiUDPECHO_LINE (10)
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+/*!
+Events of the parser
+*/
+typedef enum _udpecho_event
+{
+  UDPECHO_EVENT_NONE = 0,  /* no event/line without meaning               */
+  UDPECHO_EVENT_DATA,      /* "+IPD,<link>,<len>:<data>" complete          */
+  UDPECHO_EVENT_PROMPT,    /* '>': the ESP8266 waits for the data to send  */
+  UDPECHO_EVENT_OK,        /* line "OK"                                    */
+  UDPECHO_EVENT_ERROR,     /* line "ERROR"                                 */
+  UDPECHO_EVENT_SEND_OK,   /* line "SEND OK"                               */
+  UDPECHO_EVENT_SEND_FAIL, /* line "SEND FAIL"                             */
+  UDPECHO_EVENT_BUSY       /* line "busy ..."                              */
+} udpecho_event_t;
+
+/*!
+State of the parser
+*/
+typedef struct _udpecho_parser
+{
+  /*!
+  Current state of the state machine (UDPECHO_STATE_xxx)
+  */
+  uint8_t uiState;
+
+  /*!
+  Position in the current line or in the header "+IPD,"
+  */
+  uint8_t uiPos;
+
+  /*!
+  Connection of the last "+IPD"
+  */
+  uint8_t uiLink;
+
+  /*!
+  Number of data bytes of the "+IPD" that are still expected
+  */
+  uint16_t uiLen;
+
+  /*!
+  Sequence number of the last "+IPD" (valid if "bProbe" is set)
+  */
+  uint16_t uiSeq;
+
+  /*!
+  If this flag is set, the data of the last "+IPD" is a probe ("P<seq>")
+  */
+  bool bProbe;
+
+  /*!
+  Start of the current line
+  */
+  char acLine[uiUDPECHO_LINE + 1];
+} udpecho_parser_t;
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+/*!
+Reset the parser to the start of a line
+@param pParser Parser
+*/
+void udpecho_reset(udpecho_parser_t* pParser);
+
+/*!
+Pass the next received byte to the parser; data of "+IPD" may follow any
+line without line feed
+@param pParser Parser
+@param uiByte Received byte
+@return Event that is caused by the byte (UDPECHO_EVENT_xxx); the link and
+        the sequence number of UDPECHO_EVENT_DATA are stored in the parser
+*/
+udpecho_event_t udpecho_parse(udpecho_parser_t* pParser, uint8_t uiByte);
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#endif /* __UDPECHO_H__ */
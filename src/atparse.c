@@ -0,0 +1,224 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: atparse.c                                                          |
+| project:  ZX Spectrum Next - PING                                            |
+| author:   Stefan Zell                                                        |
+| date:     16/10/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Streaming parser for the responses of the ESP8266 to AT commands             |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 16/10/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "atparse.h"
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+States of the parser
+*/
+#define AT_STATE_START  (0x00) /* start of a line                      */
+#define AT_STATE_PLUS   (0x01) /* line starts with '+', no digit yet    */
+#define AT_STATE_DIGITS (0x02) /* reading the digits of "+<n>"          */
+#define AT_STATE_VALUE  (0x03) /* "+<n>" complete, ignore rest of line  */
+#define AT_STATE_MATCH  (0x04) /* comparing the line with the keywords  */
+#define AT_STATE_SKIP   (0x05) /* line without meaning                  */
+
+/*!
+Bitmask of all keywords (see "g_acKeyword")
+*/
+#define uiAT_MATCH_ALL (0x1F)
+
+/*!
+Index of the keyword "busy p..." that matches as prefix (see "g_acKeyword")
+*/
+#define uiAT_KEYWORD_BUSY (4)
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+/*!
+Keywords in the order of the events AT_EVENT_OK, AT_EVENT_ERROR, ...
+*/
+static const char* const g_acKeyword[] =
+{
+  "OK",
+  "ERROR",
+  "FAIL",
+  "CONNECT",
+  "busy p"
+};
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/* at_reset()                                                                 */
+/*----------------------------------------------------------------------------*/
+void at_reset(at_parser_t* pParser)
+{
+  pParser->uiState = AT_STATE_START;
+  pParser->uiPos   = 0;
+  pParser->uiMatch = uiAT_MATCH_ALL;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* at_parse()                                                                 */
+/*----------------------------------------------------------------------------*/
+at_event_t at_parse(at_parser_t* pParser, uint8_t uiByte)
+{
+  at_event_t eEvent = AT_EVENT_NONE;
+  uint8_t i;
+
+  if ('\r' == uiByte)
+  {
+    /* ignored */
+  }
+  else if ('\n' == uiByte) /* End of line */
+  {
+    if ((AT_STATE_DIGITS == pParser->uiState) || (AT_STATE_VALUE == pParser->uiState))
+    {
+      eEvent = AT_EVENT_VALUE;
+    }
+    else if (AT_STATE_MATCH == pParser->uiState)
+    {
+      for (i = 0; i < uiAT_KEYWORD_BUSY; ++i)
+      {
+        if ((pParser->uiMatch & (1 << i)) && ('\0' == g_acKeyword[i][pParser->uiPos]))
+        {
+          eEvent = (at_event_t) (AT_EVENT_OK + i);
+          break;
+        }
+      }
+    }
+
+    at_reset(pParser);
+  }
+  else
+  {
+    if (AT_STATE_START == pParser->uiState)
+    {
+      if ('+' == uiByte)
+      {
+        pParser->uiState = AT_STATE_PLUS;
+        pParser->uiValue = 0;
+        return AT_EVENT_NONE;
+      }
+
+      pParser->uiState = AT_STATE_MATCH;
+    }
+
+    switch (pParser->uiState)
+    {
+      case AT_STATE_PLUS:
+      case AT_STATE_DIGITS:
+        if (('0' <= uiByte) && ('9' >= uiByte))
+        {
+          if (pParser->uiValue < (UINT16_MAX / 10))
+          {
+            pParser->uiValue = (pParser->uiValue * 10) + (uiByte - '0');
+          }
+          else
+          {
+            pParser->uiValue = UINT16_MAX;
+          }
+
+          pParser->uiState = AT_STATE_DIGITS;
+        }
+        else
+        {
+          pParser->uiState = (AT_STATE_DIGITS == pParser->uiState ? AT_STATE_VALUE : AT_STATE_SKIP);
+        }
+        break;
+
+      case AT_STATE_MATCH:
+        for (i = 0; i <= uiAT_KEYWORD_BUSY; ++i)
+        {
+          if ((pParser->uiMatch & (1 << i)) && (g_acKeyword[i][pParser->uiPos] != (char) uiByte))
+          {
+            pParser->uiMatch &= ~(1 << i);
+          }
+        }
+
+        ++pParser->uiPos;
+
+        if ((pParser->uiMatch & (1 << uiAT_KEYWORD_BUSY)) &&
+            ('\0' == g_acKeyword[uiAT_KEYWORD_BUSY][pParser->uiPos]))
+        {
+          pParser->uiState = AT_STATE_SKIP;
+          eEvent = AT_EVENT_BUSY;
+        }
+        else if (0 == pParser->uiMatch)
+        {
+          pParser->uiState = AT_STATE_SKIP;
+        }
+        break;
+
+      default:
+        break;
+    }
+  }
+
+  return eEvent;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
@@ -0,0 +1,232 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: bankmem.c                                                          |
+| project:  ZX Spectrum Next - PING                                            |
+| author:   Stefan Zell                                                        |
+| date:     16/10/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Arena of 8K memory pages of NextOS                                           |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 16/10/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <errno.h>
+#include <arch/zxn.h>
+#include <arch/zxn/esxdos.h>
+
+#include "libzxn.h"
+#include "bankmem.h"
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+Next register of the MMU slot
+*/
+#define uiBANKMEM_MMU_REG (0x50 + uiBANKMEM_SLOT)
+
+/*!
+Address of the MMU slot
+*/
+#define pBANKMEM_BASE ((uint8_t*) (uiBANKMEM_SLOT * uiBANKMEM_PAGE_SIZE))
+
+/*!
+Result of "esx_ide_bank_alloc" if no page is free
+*/
+#define uiBANKMEM_NO_PAGE (0xFF)
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+/*!
+State of the arena; page 0 is the resident page, memory is allocated from
+the last reserved page only (no release of single blocks)
+*/
+static struct
+{
+  uint8_t  auiPage[uiBANKMEM_PAGES];
+  uint8_t  uiPages;
+  uint8_t  uiSaved;
+  uint16_t uiResident;
+  uint16_t uiFar;
+} g_tArena;
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/* bankmem_init()                                                             */
+/*----------------------------------------------------------------------------*/
+int bankmem_init(void)
+{
+  uint8_t uiPage;
+
+  if (0 != g_tArena.uiPages)
+  {
+    return EOK;
+  }
+
+  if (uiBANKMEM_NO_PAGE == (uiPage = esx_ide_bank_alloc(ESX_BANKTYPE_RAM)))
+  {
+    return ENOMEM;
+  }
+
+  g_tArena.auiPage[0] = uiPage;
+  g_tArena.uiPages    = 1;
+  g_tArena.uiSaved    = ZXN_READ_REG(uiBANKMEM_MMU_REG);
+  g_tArena.uiResident = 0;
+  g_tArena.uiFar      = uiBANKMEM_PAGE_SIZE;
+
+  ZXN_WRITE_REG(uiBANKMEM_MMU_REG, uiPage);
+
+  return EOK;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* bankmem_exit()                                                             */
+/*----------------------------------------------------------------------------*/
+void bankmem_exit(void)
+{
+  if (0 != g_tArena.uiPages)
+  {
+    ZXN_WRITE_REG(uiBANKMEM_MMU_REG, g_tArena.uiSaved);
+
+    while (0 != g_tArena.uiPages)
+    {
+      esx_ide_bank_free(ESX_BANKTYPE_RAM, g_tArena.auiPage[--g_tArena.uiPages]);
+    }
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* bankmem_alloc()                                                            */
+/*----------------------------------------------------------------------------*/
+void* bankmem_alloc(uint16_t uiSize)
+{
+  void* pReturn = 0;
+
+  /* Even sizes keep 16 bit values aligned */
+  uiSize = (uiSize + 1) & ~1;
+
+  if ((0 != g_tArena.uiPages) && (uiSize <= (uiBANKMEM_PAGE_SIZE - g_tArena.uiResident)))
+  {
+    pReturn = pBANKMEM_BASE + g_tArena.uiResident;
+    g_tArena.uiResident += uiSize;
+  }
+
+  return pReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* bankmem_falloc()                                                           */
+/*----------------------------------------------------------------------------*/
+bankmem_t bankmem_falloc(uint16_t uiSize)
+{
+  bankmem_t tReturn;
+  uint8_t uiPage;
+
+  uiSize = (uiSize + 1) & ~1;
+
+  if ((0 == g_tArena.uiPages) || (0 == uiSize) || (uiBANKMEM_PAGE_SIZE < uiSize))
+  {
+    return uiBANKMEM_NULL;
+  }
+
+  /* Reserve the next page, if the block does not fit into the current one */
+  if (uiSize > (uiBANKMEM_PAGE_SIZE - g_tArena.uiFar))
+  {
+    if ((uiBANKMEM_PAGES <= g_tArena.uiPages) ||
+        (uiBANKMEM_NO_PAGE == (uiPage = esx_ide_bank_alloc(ESX_BANKTYPE_RAM))))
+    {
+      return uiBANKMEM_NULL;
+    }
+
+    g_tArena.auiPage[g_tArena.uiPages++] = uiPage;
+    g_tArena.uiFar = 0;
+  }
+
+  tReturn = (bankmem_t) ((((bankmem_t) (g_tArena.uiPages - 1)) << 13) | g_tArena.uiFar);
+  g_tArena.uiFar += uiSize;
+
+  return tReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* bankmem_map()                                                              */
+/*----------------------------------------------------------------------------*/
+void* bankmem_map(bankmem_t tAddr)
+{
+  ZXN_WRITE_REG(uiBANKMEM_MMU_REG, g_tArena.auiPage[tAddr >> 13]);
+
+  return pBANKMEM_BASE + (tAddr & (uiBANKMEM_PAGE_SIZE - 1));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* bankmem_unmap()                                                            */
+/*----------------------------------------------------------------------------*/
+void bankmem_unmap(void)
+{
+  ZXN_WRITE_REG(uiBANKMEM_MMU_REG, g_tArena.auiPage[0]);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
@@ -0,0 +1,369 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: dash.c                                                             |
+| project:  ZX Spectrum Next - PING                                            |
+| author:   Stefan Zell                                                        |
+| date:     16/10/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Live latency graph on the ULA screen ("-d")                                  |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 16/10/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <arch/zxn.h>
+
+#include "dash.h"
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+First and last pixel row of the graph
+*/
+#define uiDASH_GRAPH_TOP    (24)
+#define uiDASH_GRAPH_BOTTOM (191)
+
+/*!
+Height of the graph [pixel]
+*/
+#define uiDASH_GRAPH_HEIGHT (uiDASH_GRAPH_BOTTOM - uiDASH_GRAPH_TOP + 1)
+
+/*!
+Pixel row of the dotted line below the counters
+*/
+#define uiDASH_SEPARATOR (20)
+
+/*!
+Round trip time up to which one pixel is one millisecond [ms]; above, one
+pixel is (1 << uiDASH_COMPRESS) milliseconds
+*/
+#define uiDASH_LINEAR   (100)
+#define uiDASH_COMPRESS (4)
+
+/*!
+Maximum number of characters of a counter
+*/
+#define uiDASH_DIGITS (5)
+
+/*!
+Attributes of the graph and of the counters
+*/
+#define uiDASH_ATTR_GRAPH (PAPER_BLACK | INK_GREEN | BRIGHT)
+#define uiDASH_ATTR_TEXT  (PAPER_BLACK | INK_WHITE | BRIGHT)
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+/*!
+Characters of the embedded font (the ROM font is not paged in while a dot
+command is running)
+*/
+static const char g_acGlyph[] = " %./0123456789agilmnopsvx";
+
+/*!
+Bitmaps of the characters in "g_acGlyph" (8 x 8)
+*/
+static const uint8_t g_auiFont[][8] =
+{
+  { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, /* ' ' */
+  { 0x00, 0x62, 0x64, 0x08, 0x10, 0x26, 0x46, 0x00 }, /* '%' */
+  { 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x00 }, /* '.' */
+  { 0x00, 0x04, 0x08, 0x10, 0x20, 0x40, 0x00, 0x00 }, /* '/' */
+  { 0x00, 0x3C, 0x46, 0x4A, 0x52, 0x62, 0x3C, 0x00 }, /* '0' */
+  { 0x00, 0x18, 0x28, 0x08, 0x08, 0x08, 0x3E, 0x00 }, /* '1' */
+  { 0x00, 0x3C, 0x42, 0x02, 0x3C, 0x40, 0x7E, 0x00 }, /* '2' */
+  { 0x00, 0x3C, 0x42, 0x0C, 0x02, 0x42, 0x3C, 0x00 }, /* '3' */
+  { 0x00, 0x08, 0x18, 0x28, 0x48, 0x7E, 0x08, 0x00 }, /* '4' */
+  { 0x00, 0x7E, 0x40, 0x7C, 0x02, 0x42, 0x3C, 0x00 }, /* '5' */
+  { 0x00, 0x3C, 0x40, 0x7C, 0x42, 0x42, 0x3C, 0x00 }, /* '6' */
+  { 0x00, 0x7E, 0x02, 0x04, 0x08, 0x10, 0x10, 0x00 }, /* '7' */
+  { 0x00, 0x3C, 0x42, 0x3C, 0x42, 0x42, 0x3C, 0x00 }, /* '8' */
+  { 0x00, 0x3C, 0x42, 0x42, 0x3E, 0x02, 0x3C, 0x00 }, /* '9' */
+  { 0x00, 0x00, 0x38, 0x04, 0x3C, 0x44, 0x3C, 0x00 }, /* 'a' */
+  { 0x00, 0x00, 0x3C, 0x44, 0x44, 0x3C, 0x04, 0x38 }, /* 'g' */
+  { 0x00, 0x10, 0x00, 0x30, 0x10, 0x10, 0x38, 0x00 }, /* 'i' */
+  { 0x00, 0x20, 0x20, 0x20, 0x20, 0x20, 0x18, 0x00 }, /* 'l' */
+  { 0x00, 0x00, 0x68, 0x54, 0x54, 0x54, 0x54, 0x00 }, /* 'm' */
+  { 0x00, 0x00, 0x78, 0x44, 0x44, 0x44, 0x44, 0x00 }, /* 'n' */
+  { 0x00, 0x00, 0x38, 0x44, 0x44, 0x44, 0x38, 0x00 }, /* 'o' */
+  { 0x00, 0x00, 0x78, 0x44, 0x44, 0x78, 0x40, 0x40 }, /* 'p' */
+  { 0x00, 0x00, 0x3C, 0x40, 0x38, 0x04, 0x78, 0x00 }, /* 's' */
+  { 0x00, 0x00, 0x44, 0x44, 0x44, 0x28, 0x10, 0x00 }, /* 'v' */
+  { 0x00, 0x00, 0x44, 0x28, 0x10, 0x28, 0x44, 0x00 }  /* 'x' */
+};
+
+/*!
+Position (column, row) and width of the counters in the order of
+"dash_counter_t"
+*/
+static const uint8_t g_auiCounterX[DASH_COUNTERS]     = {  4, 14, 24,  5, 16 };
+static const uint8_t g_auiCounterY[DASH_COUNTERS]     = {  0,  0,  0,  1,  1 };
+static const uint8_t g_auiCounterWidth[DASH_COUNTERS] = {  5,  5,  5,  3,  5 };
+
+/*!
+Round trip times marked by a dotted line in the graph [ms]
+*/
+static const uint16_t g_auiGrid[] = { 10, 100, 1000 };
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+/*!
+Characters of the counters as they are shown on the screen
+*/
+static char g_acCounter[DASH_COUNTERS][uiDASH_DIGITS];
+
+/*!
+Pixel rows of the grid lines (see "g_auiGrid")
+*/
+static uint8_t g_auiGridY[sizeof(g_auiGrid) / sizeof(g_auiGrid[0])];
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+/*!
+Returns the height of the column of a round trip time [pixel]
+*/
+static uint8_t dash_height(uint16_t uiRtt);
+
+/*!
+Draw a character at the given character position
+*/
+static void dash_char(uint8_t x, uint8_t y, char cChar);
+
+/*!
+Draw a text at the given character position
+*/
+static void dash_text(uint8_t x, uint8_t y, const char* acText);
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/* dash_init()                                                                */
+/*----------------------------------------------------------------------------*/
+void dash_init(void)
+{
+  uint8_t* pAttr;
+  uint8_t i;
+
+  zx_cls(uiDASH_ATTR_GRAPH);
+
+  /* Counters */
+  pAttr = zx_cxy2aaddr(0, 0);
+  memset(pAttr, uiDASH_ATTR_TEXT, 2 * 32);
+
+  dash_text( 0, 0, "min");
+  dash_text(10, 0, "avg");
+  dash_text(20, 0, "max");
+  dash_text(30, 0, "ms");
+  dash_text( 0, 1, "loss");
+  dash_text( 8, 1, "%");
+  dash_text(10, 1, "pings");
+
+  memset(g_acCounter, ' ', sizeof(g_acCounter));
+
+  /* Separator and grid */
+  memset(zx_pxy2saddr(0, uiDASH_SEPARATOR), 0x55, 32);
+
+  for (i = 0; i < sizeof(g_auiGrid) / sizeof(g_auiGrid[0]); ++i)
+  {
+    g_auiGridY[i] = (uint8_t) (uiDASH_GRAPH_BOTTOM + 1 - dash_height(g_auiGrid[i]));
+    memset(zx_pxy2saddr(0, g_auiGridY[i]), 0x11, 32);
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* dash_column()                                                              */
+/*----------------------------------------------------------------------------*/
+void dash_column(uint16_t uiIndex, bool bOk, uint16_t uiRtt)
+{
+  uint8_t  x = (uint8_t) uiIndex;
+  uint8_t  uiTop;
+  uint8_t  uiMask;
+  uint8_t* pAddr;
+  uint8_t  y;
+  uint8_t  i;
+
+  /* Column of the probe (cleared by the previous call or by dash_init()) */
+  uiTop  = (uint8_t) (uiDASH_GRAPH_BOTTOM + 1 - dash_height(uiRtt));
+  uiMask = zx_px2bitmask(x);
+  pAddr  = zx_pxy2saddr(x, uiDASH_GRAPH_TOP);
+
+  for (y = uiDASH_GRAPH_TOP; ; ++y)
+  {
+    if (bOk ? (y >= uiTop) : (0 == (y & 0x03)))
+    {
+      *pAddr |= uiMask;
+    }
+
+    if (uiDASH_GRAPH_BOTTOM == y)
+    {
+      break;
+    }
+
+    pAddr = zx_saddrpdown(pAddr);
+  }
+
+  /* Following column: clear it, but keep the grid */
+  ++x;
+  uiMask = zx_px2bitmask(x);
+  pAddr  = zx_pxy2saddr(x, uiDASH_GRAPH_TOP);
+  i      = 0;
+
+  for (y = uiDASH_GRAPH_TOP; ; ++y)
+  {
+    if ((i < sizeof(g_auiGridY)) && (y == g_auiGridY[i]) && (0x03 == (x & 0x03)))
+    {
+      *pAddr |= uiMask;
+    }
+    else
+    {
+      *pAddr &= (uint8_t) ~uiMask;
+    }
+
+    if ((i < sizeof(g_auiGridY)) && (y == g_auiGridY[i]))
+    {
+      ++i;
+    }
+
+    if (uiDASH_GRAPH_BOTTOM == y)
+    {
+      break;
+    }
+
+    pAddr = zx_saddrpdown(pAddr);
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* dash_counter()                                                             */
+/*----------------------------------------------------------------------------*/
+void dash_counter(dash_counter_t eCounter, uint16_t uiValue)
+{
+  char    acText[uiDASH_DIGITS];
+  char*   pText = g_acCounter[eCounter];
+  uint8_t uiWidth = g_auiCounterWidth[eCounter];
+  uint8_t i = uiWidth;
+
+  /* Right aligned without leading zeros */
+  memset(acText, ' ', sizeof(acText));
+
+  do
+  {
+    acText[--i] = (char) ('0' + (uiValue % 10));
+    uiValue /= 10;
+  }
+  while ((0 != uiValue) && (0 != i));
+
+  for (i = 0; i < uiWidth; ++i)
+  {
+    if (acText[i] != pText[i])
+    {
+      pText[i] = acText[i];
+      dash_char((uint8_t) (g_auiCounterX[eCounter] + i), g_auiCounterY[eCounter], acText[i]);
+    }
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* dash_height()                                                              */
+/*----------------------------------------------------------------------------*/
+static uint8_t dash_height(uint16_t uiRtt)
+{
+  if (uiRtt > uiDASH_LINEAR)
+  {
+    uiRtt = uiDASH_LINEAR + ((uiRtt - uiDASH_LINEAR) >> uiDASH_COMPRESS);
+  }
+
+  if (0 == uiRtt)
+  {
+    uiRtt = 1;
+  }
+
+  return (uint8_t) (uiRtt < uiDASH_GRAPH_HEIGHT ? uiRtt : uiDASH_GRAPH_HEIGHT);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* dash_char()                                                                */
+/*----------------------------------------------------------------------------*/
+static void dash_char(uint8_t x, uint8_t y, char cChar)
+{
+  const char*    pGlyph = strchr(g_acGlyph, cChar);
+  const uint8_t* pFont  = g_auiFont[(pGlyph && *pGlyph) ? pGlyph - g_acGlyph : 0];
+  uint8_t*       pAddr  = zx_cxy2saddr(x, y);
+  uint8_t        i;
+
+  for (i = 0; i < 8; ++i)
+  {
+    *pAddr = pFont[i];
+    pAddr  = zx_saddrpdown(pAddr);
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* dash_text()                                                                */
+/*----------------------------------------------------------------------------*/
+static void dash_text(uint8_t x, uint8_t y, const char* acText)
+{
+  while ('\0' != *acText)
+  {
+    dash_char(x++, y, *acText++);
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
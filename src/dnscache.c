@@ -0,0 +1,253 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: dnscache.c                                                         |
+| project:  ZX Spectrum Next - PING                                            |
+| author:   Stefan Zell                                                        |
+| date:     16/10/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Persistent cache of resolved hostnames on the SD card                        |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 16/10/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <arch/zxn/esxdos.h>
+
+#include "libzxn.h"
+#include "bankmem.h"
+#include "dnscache.h"
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+Handle of esxDOS on errors
+*/
+#define uiDNSCACHE_NO_HANDLE (0xFF)
+
+/*!
+Size of the cache file
+*/
+#define uiDNSCACHE_SIZE (uiDNSCACHE_ENTRIES * sizeof(dnscache_entry_t))
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+/*!
+Content of the cache file (allocated in the memory arena by the first
+"dnscache_load")
+*/
+static dnscache_entry_t* g_atCache;
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+/*!
+Read the current time from the RTC
+@param puiNow Current time [min]; months are counted with 31 days, so the
+       value is monotonic but expires entries up to 3 days early at the end
+       of short months
+@return "true" if a RTC is available
+*/
+static bool dnscache_now(uint32_t* puiNow);
+
+/*!
+Read the cache file into "g_atCache"; a missing or damaged file results in
+an empty cache
+@return "false" if there is no memory for the cache
+*/
+static bool dnscache_load(void);
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/* dnscache_lookup()                                                          */
+/*----------------------------------------------------------------------------*/
+bool dnscache_lookup(const char* acName, char* acAddr)
+{
+  uint32_t uiNow;
+  uint8_t i;
+
+  if (!dnscache_now(&uiNow) || !dnscache_load())
+  {
+    return false;
+  }
+
+  for (i = 0; i < uiDNSCACHE_ENTRIES; ++i)
+  {
+    if ((0 == stricmp(g_atCache[i].acName, acName)) && (uiNow < g_atCache[i].uiExpires))
+    {
+      memcpy(acAddr, g_atCache[i].acAddr, uiDNSCACHE_ADDR);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* dnscache_store()                                                           */
+/*----------------------------------------------------------------------------*/
+int dnscache_store(const char* acName, const char* acAddr)
+{
+  uint32_t uiNow;
+  uint8_t uiHandle;
+  uint8_t uiEntry = 0;
+  uint8_t i;
+  int iReturn = EOK;
+
+  if ((uiDNSCACHE_NAME <= strlen(acName)) || (uiDNSCACHE_ADDR <= strlen(acAddr)) ||
+      !dnscache_now(&uiNow) || !dnscache_load())
+  {
+    return EOK;
+  }
+
+  /* Same name, else the entry that expires first (unused entries are 0) */
+  for (i = 0; i < uiDNSCACHE_ENTRIES; ++i)
+  {
+    if (0 == stricmp(g_atCache[i].acName, acName))
+    {
+      uiEntry = i;
+      break;
+    }
+
+    if (g_atCache[i].uiExpires < g_atCache[uiEntry].uiExpires)
+    {
+      uiEntry = i;
+    }
+  }
+
+  memset(&g_atCache[uiEntry], 0, sizeof(g_atCache[uiEntry]));
+  strcpy(g_atCache[uiEntry].acName, acName);
+  strcpy(g_atCache[uiEntry].acAddr, acAddr);
+  g_atCache[uiEntry].uiExpires = uiNow + uiDNSCACHE_TTL;
+
+  if (uiDNSCACHE_NO_HANDLE == (uiHandle = esx_f_open(sDNSCACHE_FILE, ESX_MODE_WRITE | ESX_MODE_CREAT_TRUNC)))
+  {
+    return errno;
+  }
+
+  if (uiDNSCACHE_SIZE != esx_f_write(uiHandle, g_atCache, uiDNSCACHE_SIZE))
+  {
+    iReturn = errno;
+  }
+
+  esx_f_close(uiHandle);
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* dnscache_now()                                                             */
+/*----------------------------------------------------------------------------*/
+static bool dnscache_now(uint32_t* puiNow)
+{
+  struct dos_tm tNow;
+  uint16_t uiDays;
+
+  if ((0 != esx_m_getdate(&tNow)) || (0 == tNow.date))
+  {
+    return false;
+  }
+
+  /* DOS format: yyyyyyym mmmddddd / hhhhhmmm mmmsssss */
+  uiDays = ((tNow.date >> 9) * 12 + ((tNow.date >> 5) & 0x0F)) * 31 + (tNow.date & 0x1F);
+
+  *puiNow = ((uint32_t) uiDays) * 1440 + (tNow.time >> 11) * 60 + ((tNow.time >> 5) & 0x3F);
+
+  return true;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* dnscache_load()                                                            */
+/*----------------------------------------------------------------------------*/
+static bool dnscache_load(void)
+{
+  uint8_t uiHandle;
+  uint8_t i;
+
+  if ((0 == g_atCache) && (0 == (g_atCache = bankmem_alloc(uiDNSCACHE_SIZE))))
+  {
+    return false;
+  }
+
+  memset(g_atCache, 0, uiDNSCACHE_SIZE);
+
+  if (uiDNSCACHE_NO_HANDLE != (uiHandle = esx_f_open(sDNSCACHE_FILE, ESX_MODE_READ | ESX_MODE_OPEN_EXIST)))
+  {
+    if (uiDNSCACHE_SIZE != esx_f_read(uiHandle, g_atCache, uiDNSCACHE_SIZE))
+    {
+      memset(g_atCache, 0, uiDNSCACHE_SIZE);
+    }
+
+    esx_f_close(uiHandle);
+  }
+
+  /* Never trust the content of the file */
+  for (i = 0; i < uiDNSCACHE_ENTRIES; ++i)
+  {
+    g_atCache[i].acName[uiDNSCACHE_NAME - 1] = '\0';
+    g_atCache[i].acAddr[uiDNSCACHE_ADDR - 1] = '\0';
+  }
+
+  return true;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
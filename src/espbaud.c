@@ -0,0 +1,127 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: espbaud.c                                                          |
+| project:  ZX Spectrum Next - PING                                            |
+| author:   Stefan Zell                                                        |
+| date:     16/10/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Baudrate of the UART the ESP8266 is connected to                             |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 16/10/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <arch/zxn.h>
+
+#include "sysclock.h"
+#include "espbaud.h"
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+UART control: write bits 16:14 of the prescaler (ESP8266 selected, bit 6 = 0)
+*/
+#define uiUART_CTRL_PRESCALER_MSB (0x10)
+
+/*!
+UART RX port (write): bits 13:7 (bit 7 = 1) or bits 6:0 (bit 7 = 0) of the
+prescaler
+*/
+#define uiUART_PRESCALER_HIGH (0x80)
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+/*!
+Ports of the UART
+*/
+__sfr __banked __at 0x143B IO_ESPBAUD_RX;
+__sfr __banked __at 0x153B IO_ESPBAUD_CTRL;
+
+/*!
+Current baudrate [bit/s]
+*/
+static uint32_t g_uiBaud = uiESPBAUD_DEFAULT;
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/* espbaud_set()                                                              */
+/*----------------------------------------------------------------------------*/
+void espbaud_set(uint32_t uiBaud)
+{
+  uint32_t uiPrescaler = (SYSCLOCK_HZ() + (uiBaud >> 1)) / uiBaud;
+
+  IO_ESPBAUD_CTRL = uiUART_CTRL_PRESCALER_MSB | (((uint8_t) (uiPrescaler >> 14)) & 0x07);
+  IO_ESPBAUD_RX   = ((uint8_t) uiPrescaler) & 0x7F;
+  IO_ESPBAUD_RX   = uiUART_PRESCALER_HIGH | (((uint8_t) (uiPrescaler >> 7)) & 0x7F);
+
+  g_uiBaud = uiBaud;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* espbaud_get()                                                              */
+/*----------------------------------------------------------------------------*/
+uint32_t espbaud_get(void)
+{
+  return g_uiBaud;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
@@ -0,0 +1,298 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: espcap.c                                                           |
+| project:  ZX Spectrum Next - PING                                            |
+| author:   Stefan Zell                                                        |
+| date:     16/10/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Capture of all bytes sent to and received from the ESP8266 ("-C file")       |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 16/10/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <arch/zxn/esxdos.h>
+
+#include "libzxn.h"
+#include "timer.h"
+#include "bankmem.h"
+#include "espcap.h"
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+Handle of esxDOS if no file is open
+*/
+#define uiESPCAP_NO_HANDLE (0xFF)
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+/*!
+State of the capture; the records are collected in a sector sized buffer
+(allocated in the memory arena by the first "espcap_open"). Received bytes
+are collected in "acChunk" until a line is complete.
+*/
+static struct
+{
+  uint8_t* acBuffer;
+  uint16_t uiCount;
+  uint8_t  uiHandle;
+  uint8_t  uiChunk;
+  int      iError;
+  uint32_t uiStart;
+  char     acChunk[uiESPCAP_CHUNK_SIZE];
+} g_tCap = { .uiHandle = uiESPCAP_NO_HANDLE };
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+/*!
+Append a record to the buffer; the buffer is written if it is full
+@param uiDir Direction (uiESPCAP_DIR_xxx)
+@param acData Data bytes
+@param uiLen Number of data bytes (max. 255)
+*/
+static void espcap_record(uint8_t uiDir, const char* acData, uint8_t uiLen);
+
+/*!
+Append bytes to the buffer; the buffer is written if it is full
+*/
+static void espcap_put(const void* pData, uint16_t uiLen);
+
+/*!
+Write the buffer to the file
+*/
+static void espcap_flush(void);
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/* espcap_open()                                                              */
+/*----------------------------------------------------------------------------*/
+int espcap_open(const char* acFile)
+{
+  espcap_close();
+
+  if ((0 == g_tCap.acBuffer) && (0 == (g_tCap.acBuffer = bankmem_alloc(uiESPCAP_BUFFER_SIZE))))
+  {
+    return ENOMEM;
+  }
+
+  if (uiESPCAP_NO_HANDLE == (g_tCap.uiHandle = esx_f_open((char*) acFile, ESX_MODE_WRITE | ESX_MODE_CREAT_TRUNC)))
+  {
+    return errno;
+  }
+
+  g_tCap.uiCount = 0;
+  g_tCap.uiChunk = 0;
+  g_tCap.iError  = EOK;
+  g_tCap.uiStart = timer_now();
+
+  return EOK;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* espcap_tx()                                                                */
+/*----------------------------------------------------------------------------*/
+void espcap_tx(const char* acCmd)
+{
+  uint16_t uiLen;
+
+  if (uiESPCAP_NO_HANDLE == g_tCap.uiHandle)
+  {
+    return;
+  }
+
+  /* A partial line received before the command is a record of its own */
+  if (0 != g_tCap.uiChunk)
+  {
+    espcap_record(uiESPCAP_DIR_RX, g_tCap.acChunk, g_tCap.uiChunk);
+    g_tCap.uiChunk = 0;
+  }
+
+  uiLen = (uint16_t) strlen(acCmd);
+
+  do
+  {
+    uint8_t uiPart = (uiLen > 0xFF ? 0xFF : (uint8_t) uiLen);
+
+    espcap_record(uiESPCAP_DIR_TX, acCmd, uiPart);
+    acCmd += uiPart;
+    uiLen -= uiPart;
+  }
+  while (0 != uiLen);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* espcap_rx()                                                                */
+/*----------------------------------------------------------------------------*/
+void espcap_rx(uint8_t uiByte)
+{
+  if (uiESPCAP_NO_HANDLE == g_tCap.uiHandle)
+  {
+    return;
+  }
+
+  g_tCap.acChunk[g_tCap.uiChunk++] = (char) uiByte;
+
+  if (('\n' == uiByte) || (sizeof(g_tCap.acChunk) <= g_tCap.uiChunk))
+  {
+    espcap_record(uiESPCAP_DIR_RX, g_tCap.acChunk, g_tCap.uiChunk);
+    g_tCap.uiChunk = 0;
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* espcap_close()                                                             */
+/*----------------------------------------------------------------------------*/
+int espcap_close(void)
+{
+  int iReturn = EOK;
+
+  if (uiESPCAP_NO_HANDLE != g_tCap.uiHandle)
+  {
+    if (0 != g_tCap.uiChunk)
+    {
+      espcap_record(uiESPCAP_DIR_RX, g_tCap.acChunk, g_tCap.uiChunk);
+      g_tCap.uiChunk = 0;
+    }
+
+    espcap_flush();
+    iReturn = g_tCap.iError;
+
+    if ((0 != esx_f_close(g_tCap.uiHandle)) && (EOK == iReturn))
+    {
+      iReturn = errno;
+    }
+
+    g_tCap.uiHandle = uiESPCAP_NO_HANDLE;
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* espcap_record()                                                            */
+/*----------------------------------------------------------------------------*/
+static void espcap_record(uint8_t uiDir, const char* acData, uint8_t uiLen)
+{
+  uint8_t  auiHeader[uiESPCAP_HEADER_SIZE];
+  uint32_t uiTime = TIMER_TICKS_TO_100US(timer_now() - g_tCap.uiStart);
+
+  /* Byte by byte: the file format does not depend on the compiler */
+  auiHeader[0] = (uint8_t) uiTime;
+  auiHeader[1] = (uint8_t) (uiTime >> 8);
+  auiHeader[2] = (uint8_t) (uiTime >> 16);
+  auiHeader[3] = (uint8_t) (uiTime >> 24);
+  auiHeader[4] = uiDir;
+  auiHeader[5] = uiLen;
+
+  espcap_put(auiHeader, sizeof(auiHeader));
+  espcap_put(acData, uiLen);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* espcap_put()                                                               */
+/*----------------------------------------------------------------------------*/
+static void espcap_put(const void* pData, uint16_t uiLen)
+{
+  const uint8_t* pByte = (const uint8_t*) pData;
+  uint16_t uiPart;
+
+  while (0 != uiLen)
+  {
+    uiPart = uiESPCAP_BUFFER_SIZE - g_tCap.uiCount;
+    uiPart = (uiLen < uiPart ? uiLen : uiPart);
+
+    memcpy(&g_tCap.acBuffer[g_tCap.uiCount], pByte, uiPart);
+    g_tCap.uiCount += uiPart;
+    pByte += uiPart;
+    uiLen -= uiPart;
+
+    if (uiESPCAP_BUFFER_SIZE <= g_tCap.uiCount)
+    {
+      espcap_flush();
+    }
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* espcap_flush()                                                             */
+/*----------------------------------------------------------------------------*/
+static void espcap_flush(void)
+{
+  if (0 != g_tCap.uiCount)
+  {
+    if ((g_tCap.uiCount != esx_f_write(g_tCap.uiHandle, g_tCap.acBuffer, g_tCap.uiCount)) &&
+        (EOK == g_tCap.iError))
+    {
+      g_tCap.iError = errno;
+    }
+
+    g_tCap.uiCount = 0;
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
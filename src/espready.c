@@ -0,0 +1,170 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: espready.c                                                         |
+| project:  ZX Spectrum Next - PING                                            |
+| author:   Stefan Zell                                                        |
+| date:     16/10/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Readiness record of the ESP8266 (state left by the last run)                 |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 16/10/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <arch/zxn/esxdos.h>
+
+#include "libzxn.h"
+#include "espready.h"
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+Handle of esxDOS on errors
+*/
+#define uiESPREADY_NO_HANDLE (0xFF)
+
+/*!
+Signature of the file (detects foreign or outdated files)
+*/
+#define uiESPREADY_MAGIC (0x5245) /* "ER" */
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+/*!
+Content of the file as read by "espready_load"
+*/
+static struct
+{
+  uint16_t   uiMagic;
+  espready_t tReady;
+} g_tFile;
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/* espready_load()                                                            */
+/*----------------------------------------------------------------------------*/
+bool espready_load(espready_t* pReady)
+{
+  uint8_t uiHandle;
+
+  memset(&g_tFile, 0, sizeof(g_tFile));
+
+  if (uiESPREADY_NO_HANDLE != (uiHandle = esx_f_open(sESPREADY_FILE, ESX_MODE_READ | ESX_MODE_OPEN_EXIST)))
+  {
+    if (sizeof(g_tFile) != esx_f_read(uiHandle, &g_tFile, sizeof(g_tFile)))
+    {
+      memset(&g_tFile, 0, sizeof(g_tFile));
+    }
+
+    esx_f_close(uiHandle);
+  }
+
+  if ((uiESPREADY_MAGIC != g_tFile.uiMagic) || (0 == g_tFile.tReady.uiBaud))
+  {
+    return false;
+  }
+
+  memcpy(pReady, &g_tFile.tReady, sizeof(espready_t));
+
+  return true;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* espready_store()                                                           */
+/*----------------------------------------------------------------------------*/
+int espready_store(const espready_t* pReady)
+{
+  uint8_t uiHandle;
+  int iReturn = EOK;
+
+  /* Usually nothing changed: spare the SD card */
+  if ((uiESPREADY_MAGIC == g_tFile.uiMagic) &&
+      (g_tFile.tReady.uiBaud == pReady->uiBaud) &&
+      (g_tFile.tReady.uiFlags == pReady->uiFlags))
+  {
+    return EOK;
+  }
+
+  memset(&g_tFile, 0, sizeof(g_tFile));
+  g_tFile.uiMagic = uiESPREADY_MAGIC;
+  g_tFile.tReady.uiBaud  = pReady->uiBaud;
+  g_tFile.tReady.uiFlags = pReady->uiFlags;
+
+  if (uiESPREADY_NO_HANDLE == (uiHandle = esx_f_open(sESPREADY_FILE, ESX_MODE_WRITE | ESX_MODE_CREAT_TRUNC)))
+  {
+    return errno;
+  }
+
+  if (sizeof(g_tFile) != esx_f_write(uiHandle, &g_tFile, sizeof(g_tFile)))
+  {
+    iReturn = errno;
+  }
+
+  esx_f_close(uiHandle);
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
@@ -0,0 +1,301 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: esprx.c                                                            |
+| project:  ZX Spectrum Next - PING                                            |
+| author:   Stefan Zell                                                        |
+| date:     16/10/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Interrupt driven receive path of the ESP8266 UART                            |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 16/10/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <intrinsic.h>
+#include <im2.h>
+#include <arch/zxn.h>
+
+#include "esprx.h"
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+UART status: RX FIFO is not empty
+*/
+#define uiUART_RX_AVAIL (0x01)
+
+/*!
+Next registers of the interrupt controller
+*/
+#define uiREG_INT_CONTROL  (0xC0)
+#define uiREG_INT_ENABLE_2 (0xC6)
+#define uiREG_INT_STATUS_2 (0xCA)
+
+/*!
+Interrupt control: hardware IM2 mode
+*/
+#define uiINT_CONTROL_IM2 (0x01)
+
+/*!
+Interrupt enable/status 2: UART0 (ESP8266) RX available
+*/
+#define uiINT_UART0_RX (0x01)
+
+/*!
+Number of vectors of the hardware IM2 mode
+*/
+#define uiVECTOR_COUNT (0x10)
+
+/*!
+Vector of the UART0 RX interrupt (priority 1)
+*/
+#define uiVECTOR_UART0_RX (0x01)
+
+/*!
+Value of the I register used by NextOS
+*/
+#define uiNEXTOS_I (0x3F)
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+/*!
+Ports of the UART (the ESP8266 is selected by "esp_open")
+*/
+__sfr __banked __at 0x133B IO_ESPRX_STATUS;
+__sfr __banked __at 0x143B IO_ESPRX_DATA;
+
+/*!
+Receive ring buffer; written by the ISR ("uiHead"), read by the application
+("uiTail"). 8 bit indices are read and written atomically.
+*/
+static struct
+{
+  uint8_t auiData[uiESPRX_RING_SIZE];
+  volatile uint8_t uiHead;
+  volatile uint8_t uiTail;
+  esprx_stats_t tStats;
+} g_tRing;
+
+/*!
+Memory for the vector table; the table itself has to start at a 32 byte
+boundary (see "esprx_init")
+*/
+static uint16_t g_auiVectors[2 * uiVECTOR_COUNT];
+
+/*!
+Backup of the registers of the interrupt controller
+*/
+static uint8_t g_uiIntControl;
+static uint8_t g_uiIntEnable2;
+
+/*!
+If this flag is set, the ISR is installed
+*/
+static bool g_bInstalled = false;
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/* esprx_isr()                                                                */
+/*----------------------------------------------------------------------------*/
+IM2_DEFINE_ISR(esprx_isr)
+{
+  uint8_t uiNext;
+  uint8_t uiLevel;
+
+  while (IO_ESPRX_STATUS & uiUART_RX_AVAIL)
+  {
+    uiNext = (uint8_t) ((g_tRing.uiHead + 1) & uiESPRX_RING_MASK);
+
+    if (uiNext != g_tRing.uiTail)
+    {
+      g_tRing.auiData[g_tRing.uiHead] = IO_ESPRX_DATA;
+      g_tRing.uiHead = uiNext;
+    }
+    else
+    {
+      uiNext = IO_ESPRX_DATA;
+      ++g_tRing.tStats.uiOverruns;
+    }
+  }
+
+  uiLevel = (uint8_t) ((g_tRing.uiHead - g_tRing.uiTail) & uiESPRX_RING_MASK);
+
+  if (uiLevel > g_tRing.tStats.uiHighWater)
+  {
+    g_tRing.tStats.uiHighWater = uiLevel;
+  }
+
+  ZXN_NEXTREG(uiREG_INT_STATUS_2, uiINT_UART0_RX);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* esprx_isr_default()                                                        */
+/*----------------------------------------------------------------------------*/
+IM2_DEFINE_ISR(esprx_isr_default)
+{
+  /* ULA/line interrupts are acknowledged only */
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* esprx_init()                                                               */
+/*----------------------------------------------------------------------------*/
+void esprx_init(void)
+{
+  uint16_t* pTable;
+  uint8_t i;
+
+  if (!g_bInstalled)
+  {
+    /* Vector table at the next 32 byte boundary */
+    pTable = (uint16_t*) ((((uint16_t) g_auiVectors) + 0x1F) & 0xFFE0);
+
+    for (i = 0; i < uiVECTOR_COUNT; ++i)
+    {
+      pTable[i] = (uint16_t) esprx_isr_default;
+    }
+
+    pTable[uiVECTOR_UART0_RX] = (uint16_t) esprx_isr;
+
+    g_tRing.uiHead = 0;
+    g_tRing.uiTail = 0;
+    g_tRing.tStats.uiHighWater = 0;
+    g_tRing.tStats.uiOverruns  = 0;
+
+    intrinsic_di();
+
+    g_uiIntControl = ZXN_READ_REG(uiREG_INT_CONTROL);
+    g_uiIntEnable2 = ZXN_READ_REG(uiREG_INT_ENABLE_2);
+
+    im2_init((void*) (((uint16_t) pTable) & 0xFF00));
+    ZXN_WRITE_REG(uiREG_INT_CONTROL, (((uint16_t) pTable) & 0xE0) | uiINT_CONTROL_IM2);
+    ZXN_WRITE_REG(uiREG_INT_STATUS_2, uiINT_UART0_RX);
+    ZXN_WRITE_REG(uiREG_INT_ENABLE_2, g_uiIntEnable2 | uiINT_UART0_RX);
+
+    g_bInstalled = true;
+
+    intrinsic_ei();
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* esprx_exit()                                                               */
+/*----------------------------------------------------------------------------*/
+void esprx_exit(void)
+{
+  if (g_bInstalled)
+  {
+    intrinsic_di();
+
+    ZXN_WRITE_REG(uiREG_INT_ENABLE_2, g_uiIntEnable2);
+    ZXN_WRITE_REG(uiREG_INT_CONTROL, g_uiIntControl & 0xF9);
+
+    /* Back to IM1 with the I register of NextOS */
+    im2_init((void*) (uiNEXTOS_I << 8));
+    intrinsic_im_1();
+
+    g_bInstalled = false;
+
+    intrinsic_ei();
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* esprx_flush()                                                              */
+/*----------------------------------------------------------------------------*/
+void esprx_flush(void)
+{
+  g_tRing.uiTail = g_tRing.uiHead;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* esprx_getc()                                                               */
+/*----------------------------------------------------------------------------*/
+int esprx_getc(void)
+{
+  uint8_t uiByte;
+
+  if (g_tRing.uiTail == g_tRing.uiHead)
+  {
+    return -1;
+  }
+
+  uiByte = g_tRing.auiData[g_tRing.uiTail];
+  g_tRing.uiTail = (uint8_t) ((g_tRing.uiTail + 1) & uiESPRX_RING_MASK);
+
+  return uiByte;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* esprx_stats()                                                              */
+/*----------------------------------------------------------------------------*/
+const esprx_stats_t* esprx_stats(void)
+{
+  return &g_tRing.tStats;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
@@ -0,0 +1,376 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: fmt.c                                                              |
+| project:  ZX Spectrum Next - PING                                            |
+| author:   Stefan Zell                                                        |
+| date:     16/10/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Minimal formatter for the output of the application                          |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 16/10/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdarg.h>
+
+#include "fmt.h"
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+Maximum number of digits of a 32 bit value
+*/
+#define uiFMT_DIGITS (10)
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+/*!
+Destination of the formatter: a string or a stream (through the buffer)
+*/
+typedef struct _fmt_sink
+{
+  /*!
+  Buffer
+  */
+  char* pBuffer;
+
+  /*!
+  Size of the buffer
+  */
+  uint16_t uiSize;
+
+  /*!
+  Number of characters in the buffer
+  */
+  uint16_t uiPos;
+
+  /*!
+  Number of characters of the complete result
+  */
+  uint16_t uiTotal;
+
+  /*!
+  Stream the buffer is written to if it is full; 0 = string
+  */
+  FILE* pStream;
+} fmt_sink_t;
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+/*!
+Format a string into the sink
+*/
+static void fmt_sink(fmt_sink_t* pSink, const char* acFmt, va_list args);
+
+/*!
+Append characters to the sink
+*/
+static void fmt_write(fmt_sink_t* pSink, const char* acText, uint16_t uiLen, uint8_t uiWidth, char cPad);
+
+/*!
+Write the buffer of a stream sink to the stream
+*/
+static void fmt_flush(fmt_sink_t* pSink);
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/* fmt_vformat()                                                              */
+/*----------------------------------------------------------------------------*/
+uint16_t fmt_vformat(char* acBuffer, uint16_t uiSize, const char* acFmt, va_list args)
+{
+  fmt_sink_t tSink;
+
+  tSink.pBuffer = acBuffer;
+  tSink.uiSize  = uiSize;
+  tSink.uiPos   = 0;
+  tSink.uiTotal = 0;
+  tSink.pStream = 0;
+
+  fmt_sink(&tSink, acFmt, args);
+
+  if (0 != uiSize)
+  {
+    acBuffer[tSink.uiPos] = '\0';
+  }
+
+  return tSink.uiTotal;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* fmt_format()                                                               */
+/*----------------------------------------------------------------------------*/
+uint16_t fmt_format(char* acBuffer, uint16_t uiSize, const char* acFmt, ...)
+{
+  uint16_t uiReturn;
+  va_list args;
+
+  va_start(args, acFmt);
+  uiReturn = fmt_vformat(acBuffer, uiSize, acFmt, args);
+  va_end(args);
+
+  return uiReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* fmt_vprint()                                                               */
+/*----------------------------------------------------------------------------*/
+uint16_t fmt_vprint(FILE* pStream, const char* acFmt, va_list args)
+{
+  char acBuffer[uiFMT_STREAM_BUFFER];
+  fmt_sink_t tSink;
+
+  tSink.pBuffer = acBuffer;
+  tSink.uiSize  = sizeof(acBuffer);
+  tSink.uiPos   = 0;
+  tSink.uiTotal = 0;
+  tSink.pStream = pStream;
+
+  fmt_sink(&tSink, acFmt, args);
+  fmt_flush(&tSink);
+
+  return tSink.uiTotal;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* fmt_sink()                                                                 */
+/*----------------------------------------------------------------------------*/
+static void fmt_sink(fmt_sink_t* pSink, const char* acFmt, va_list args)
+{
+  char acDigits[uiFMT_DIGITS + 1];
+  const char* pStart;
+  const char* pText;
+  uint8_t uiWidth;
+  char cPad;
+  bool bLong;
+
+  while ('\0' != *acFmt)
+  {
+    /* Literal text up to the next conversion */
+    pStart = acFmt;
+
+    while (('\0' != *acFmt) && ('%' != *acFmt))
+    {
+      ++acFmt;
+    }
+
+    if (acFmt != pStart)
+    {
+      fmt_write(pSink, pStart, (uint16_t) (acFmt - pStart), 0, ' ');
+    }
+
+    if ('\0' == *acFmt)
+    {
+      break;
+    }
+
+    /* Flag, width and length of the conversion */
+    ++acFmt;
+    cPad    = ' ';
+    uiWidth = 0;
+    bLong   = false;
+
+    if ('0' == *acFmt)
+    {
+      cPad = '0';
+      ++acFmt;
+    }
+
+    while (('0' <= *acFmt) && ('9' >= *acFmt))
+    {
+      uiWidth = (uint8_t) ((uiWidth * 10) + (*acFmt++ - '0'));
+    }
+
+    if ('l' == *acFmt)
+    {
+      bLong = true;
+      ++acFmt;
+    }
+
+    /* Conversion */
+    switch (*acFmt)
+    {
+      case 's':
+        pText = va_arg(args, const char*);
+        pStart = pText;
+
+        while ('\0' != *pText)
+        {
+          ++pText;
+        }
+
+        fmt_write(pSink, pStart, (uint16_t) (pText - pStart), uiWidth, ' ');
+        break;
+
+      case 'c':
+        acDigits[0] = (char) va_arg(args, int);
+        fmt_write(pSink, acDigits, 1, uiWidth, ' ');
+        break;
+
+      case 'd':
+      case 'u':
+      {
+        char* pDigit = &acDigits[sizeof(acDigits)];
+        bool bNegative = false;
+
+        if (bLong)
+        {
+          uint32_t uiValue = (uint32_t) va_arg(args, unsigned long);
+
+          do
+          {
+            *--pDigit = (char) ('0' + (uiValue % 10));
+            uiValue /= 10;
+          }
+          while (0 != uiValue);
+        }
+        else
+        {
+          /* 16 bit arithmetic is much faster on the Z80 */
+          uint16_t uiValue = (uint16_t) va_arg(args, unsigned int);
+
+          if (('d' == *acFmt) && (0 != (uiValue & 0x8000)))
+          {
+            bNegative = true;
+            uiValue   = (uint16_t) (0 - uiValue);
+          }
+
+          do
+          {
+            *--pDigit = (char) ('0' + (uiValue % 10));
+            uiValue /= 10;
+          }
+          while (0 != uiValue);
+        }
+
+        if (bNegative)
+        {
+          fmt_write(pSink, "-", 1, 0, ' ');
+          uiWidth = (0 != uiWidth ? uiWidth - 1 : 0);
+        }
+
+        fmt_write(pSink, pDigit, (uint16_t) (&acDigits[sizeof(acDigits)] - pDigit), uiWidth, cPad);
+        break;
+      }
+
+      case '\0':
+        continue;
+
+      default: /* '%' and unknown conversions are written as they are */
+        fmt_write(pSink, acFmt, 1, 0, ' ');
+        break;
+    }
+
+    ++acFmt;
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* fmt_write()                                                                */
+/*----------------------------------------------------------------------------*/
+static void fmt_write(fmt_sink_t* pSink, const char* acText, uint16_t uiLen, uint8_t uiWidth, char cPad)
+{
+  uint16_t uiPad = (uiWidth > uiLen ? uiWidth - uiLen : 0);
+
+  pSink->uiTotal += uiPad + uiLen;
+
+  while (0 != (uiPad + uiLen))
+  {
+    /* One byte of the buffer is kept for the terminating zero */
+    if ((pSink->uiPos + 1) >= pSink->uiSize)
+    {
+      if (0 == pSink->pStream)
+      {
+        break;
+      }
+
+      fmt_flush(pSink);
+    }
+
+    if (0 != uiPad)
+    {
+      pSink->pBuffer[pSink->uiPos++] = cPad;
+      --uiPad;
+    }
+    else
+    {
+      pSink->pBuffer[pSink->uiPos++] = *acText++;
+      --uiLen;
+    }
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* fmt_flush()                                                                */
+/*----------------------------------------------------------------------------*/
+static void fmt_flush(fmt_sink_t* pSink)
+{
+  if (0 != pSink->uiPos)
+  {
+    fwrite(pSink->pBuffer, 1, pSink->uiPos, pSink->pStream);
+    pSink->uiPos = 0;
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
@@ -0,0 +1,335 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: histo.c                                                            |
+| project:  ZX Spectrum Next - PING                                            |
+| author:   Stefan Zell                                                        |
+| date:     16/10/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Streaming latency histogram with logarithmic buckets                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 16/10/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "histo.h"
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+/*!
+Returns the index of the bucket of the given value
+*/
+static uint8_t histo_index(uint16_t uiValue);
+
+/*!
+Returns the largest value of the given bucket
+*/
+static uint16_t histo_upper(uint8_t uiIndex);
+
+/*!
+Halve all buckets and sums of the histogram
+*/
+static void histo_halve(histo_t* pHisto);
+
+/*!
+Integer square root
+*/
+static uint16_t histo_sqrt(uint32_t uiValue);
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/* histo_index()                                                              */
+/*----------------------------------------------------------------------------*/
+static uint8_t histo_index(uint16_t uiValue)
+{
+  uint8_t uiShift;
+  uint16_t uiTemp;
+
+  if (uiValue < uiHISTO_LINEAR)
+  {
+    return (uint8_t) uiValue;
+  }
+
+  /* uiShift = position of the MSB - 3 (1 for 16 .. 31) */
+  uiShift = 1;
+  uiTemp  = uiValue >> 5;
+
+  while (0 != uiTemp)
+  {
+    ++uiShift;
+    uiTemp >>= 1;
+  }
+
+  return (uint8_t) (uiHISTO_LINEAR + ((uiShift - 1) * uiHISTO_SUB) + ((uiValue >> uiShift) & (uiHISTO_SUB - 1)));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* histo_upper()                                                              */
+/*----------------------------------------------------------------------------*/
+static uint16_t histo_upper(uint8_t uiIndex)
+{
+  uint8_t uiShift;
+
+  if (uiIndex < uiHISTO_LINEAR)
+  {
+    return uiIndex;
+  }
+
+  uiIndex -= uiHISTO_LINEAR;
+  uiShift  = (uint8_t) (1 + (uiIndex / uiHISTO_SUB));
+
+  return (uint16_t) (((uiHISTO_SUB + (uiIndex & (uiHISTO_SUB - 1))) << uiShift) + ((1 << uiShift) - 1));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* histo_halve()                                                              */
+/*----------------------------------------------------------------------------*/
+static void histo_halve(histo_t* pHisto)
+{
+  uint8_t i;
+
+  pHisto->uiCount = 0;
+
+  for (i = 0; i < uiHISTO_BUCKETS; ++i)
+  {
+    pHisto->auiBucket[i] >>= 1;
+    pHisto->uiCount += pHisto->auiBucket[i];
+  }
+
+  pHisto->uiSum  >>= 1;
+  pHisto->uiSum2Lo = (pHisto->uiSum2Lo >> 1) | (((uint32_t) (pHisto->uiSum2Hi & 0x01)) << 31);
+  pHisto->uiSum2Hi >>= 1;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* histo_sqrt()                                                               */
+/*----------------------------------------------------------------------------*/
+static uint16_t histo_sqrt(uint32_t uiValue)
+{
+  uint32_t uiResult = 0;
+  uint32_t uiBit    = ((uint32_t) 1) << 30;
+
+  while (uiBit > uiValue)
+  {
+    uiBit >>= 2;
+  }
+
+  while (0 != uiBit)
+  {
+    if (uiValue >= (uiResult + uiBit))
+    {
+      uiValue  -= uiResult + uiBit;
+      uiResult  = (uiResult >> 1) + uiBit;
+    }
+    else
+    {
+      uiResult >>= 1;
+    }
+
+    uiBit >>= 2;
+  }
+
+  return (uint16_t) uiResult;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* histo_reset()                                                              */
+/*----------------------------------------------------------------------------*/
+void histo_reset(histo_t* pHisto)
+{
+  uint8_t i;
+
+  for (i = 0; i < uiHISTO_BUCKETS; ++i)
+  {
+    pHisto->auiBucket[i] = 0;
+  }
+
+  pHisto->uiCount  = 0;
+  pHisto->uiSum    = 0;
+  pHisto->uiSum2Lo = 0;
+  pHisto->uiSum2Hi = 0;
+  pHisto->uiMin    = UINT16_MAX;
+  pHisto->uiMax    = 0;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* histo_add()                                                                */
+/*----------------------------------------------------------------------------*/
+void histo_add(histo_t* pHisto, uint16_t uiValue)
+{
+  uint8_t  uiIndex  = histo_index(uiValue);
+  uint32_t uiSquare = ((uint32_t) uiValue) * uiValue;
+
+  if ((UINT16_MAX == pHisto->uiCount) || (UINT16_MAX == pHisto->auiBucket[uiIndex]))
+  {
+    histo_halve(pHisto);
+  }
+
+  ++pHisto->auiBucket[uiIndex];
+  ++pHisto->uiCount;
+
+  pHisto->uiSum    += uiValue;
+  pHisto->uiSum2Lo += uiSquare;
+
+  if (pHisto->uiSum2Lo < uiSquare) /* carry */
+  {
+    ++pHisto->uiSum2Hi;
+  }
+
+  if (uiValue < pHisto->uiMin)
+  {
+    pHisto->uiMin = uiValue;
+  }
+
+  if (uiValue > pHisto->uiMax)
+  {
+    pHisto->uiMax = uiValue;
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* histo_percentile()                                                         */
+/*----------------------------------------------------------------------------*/
+uint16_t histo_percentile(const histo_t* pHisto, uint8_t uiPercent)
+{
+  uint32_t uiRank;
+  uint16_t uiSum = 0;
+  uint16_t uiValue;
+  uint8_t i;
+
+  if (0 == pHisto->uiCount)
+  {
+    return 0;
+  }
+
+  uiRank = ((((uint32_t) pHisto->uiCount) * uiPercent) + 99) / 100;
+  uiRank = (0 == uiRank ? 1 : uiRank);
+
+  for (i = 0; i < uiHISTO_BUCKETS; ++i)
+  {
+    uiSum += pHisto->auiBucket[i];
+
+    if (uiSum >= uiRank)
+    {
+      break;
+    }
+  }
+
+  uiValue = histo_upper(i < uiHISTO_BUCKETS ? i : (uiHISTO_BUCKETS - 1));
+
+  /* The bucket may reach beyond the values seen */
+  if (uiValue < pHisto->uiMin)
+  {
+    uiValue = pHisto->uiMin;
+  }
+  else if (uiValue > pHisto->uiMax)
+  {
+    uiValue = pHisto->uiMax;
+  }
+
+  return uiValue;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* histo_mdev()                                                               */
+/*----------------------------------------------------------------------------*/
+uint16_t histo_mdev(const histo_t* pHisto)
+{
+  uint16_t uiCount = pHisto->uiCount;
+  uint32_t uiMean;
+  uint32_t uiRest;
+  uint32_t uiTemp;
+  uint32_t uiMean2;
+  uint32_t uiCorr;
+
+  if (0 == uiCount)
+  {
+    return 0;
+  }
+
+  /* Mean: uiMean + uiRest / uiCount */
+  uiMean = pHisto->uiSum / uiCount;
+  uiRest = pHisto->uiSum % uiCount;
+
+  /* Mean of the squares: 48 / 16 bit division in two steps (uiSum2Hi < uiCount) */
+  uiTemp  = (((uint32_t) pHisto->uiSum2Hi) << 16) | (pHisto->uiSum2Lo >> 16);
+  uiMean2 = (uiTemp / uiCount) << 16;
+  uiTemp  = ((uiTemp % uiCount) << 16) | (pHisto->uiSum2Lo & 0xFFFF);
+  uiMean2 |= uiTemp / uiCount;
+
+  /* Variance = E(x^2) - E(x)^2; E(x)^2 = uiMean^2 + 2 * uiMean * uiRest / uiCount (+ < 1) */
+  uiCorr = (uiMean * uiMean) + (2 * ((uiMean * uiRest) / uiCount));
+
+  return histo_sqrt(uiMean2 > uiCorr ? uiMean2 - uiCorr : 0);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
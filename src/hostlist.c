@@ -0,0 +1,242 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: hostlist.c                                                         |
+| project:  ZX Spectrum Next - PING                                            |
+| author:   Stefan Zell                                                        |
+| date:     16/10/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Host list of the batch mode ("-f file")                                      |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 16/10/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <arch/zxn/esxdos.h>
+
+#include "libzxn.h"
+#include "hostlist.h"
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+Handle of esxDOS if no file is open
+*/
+#define uiHOSTLIST_NO_HANDLE (0xFF)
+
+/*!
+Result of "hostlist_getc" at the end of the file
+*/
+#define iHOSTLIST_EOF (-1)
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+/*!
+State of the host list; the file is read in small blocks, so the list may be
+longer than the available memory
+*/
+static struct
+{
+  uint8_t uiHandle;
+  uint8_t uiPos;
+  uint8_t uiLen;
+  char    acBuffer[uiHOSTLIST_BUFFER_SIZE];
+} g_tList = { .uiHandle = uiHOSTLIST_NO_HANDLE };
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+/*!
+Read the next character of the host list
+@return Character or iHOSTLIST_EOF
+*/
+static int hostlist_getc(void);
+
+/*!
+Check for a blank (space, tab)
+@return "true" if the character is a blank
+*/
+static bool hostlist_blank(int iChar);
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/* hostlist_open()                                                            */
+/*----------------------------------------------------------------------------*/
+int hostlist_open(const char* acFile)
+{
+  hostlist_close();
+
+  if (uiHOSTLIST_NO_HANDLE == (g_tList.uiHandle = esx_f_open((char*) acFile, ESX_MODE_READ | ESX_MODE_OPEN_EXIST)))
+  {
+    return errno;
+  }
+
+  g_tList.uiPos = 0;
+  g_tList.uiLen = 0;
+
+  return EOK;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* hostlist_next()                                                            */
+/*----------------------------------------------------------------------------*/
+bool hostlist_next(char* acHost, uint16_t uiSize, uint16_t* puiCount)
+{
+  int iChar;
+  uint16_t uiLen;
+
+  if (uiHOSTLIST_NO_HANDLE == g_tList.uiHandle)
+  {
+    return false;
+  }
+
+  do
+  {
+    uiLen     = 0;
+    *puiCount = 0;
+
+    do
+    {
+      iChar = hostlist_getc();
+    } while (hostlist_blank(iChar));
+
+    if (iHOSTLIST_EOF == iChar)
+    {
+      return false;
+    }
+
+    /* Name of the host ends at the first blank or control character */
+    while (' ' < iChar)
+    {
+      if (uiLen < (uiSize - 1))
+      {
+        acHost[uiLen++] = (char) iChar;
+      }
+
+      iChar = hostlist_getc();
+    }
+
+    acHost[uiLen] = '\0';
+
+    while (hostlist_blank(iChar))
+    {
+      iChar = hostlist_getc();
+    }
+
+    while (('0' <= iChar) && ('9' >= iChar))
+    {
+      *puiCount = (*puiCount * 10) + (iChar - '0');
+      iChar = hostlist_getc();
+    }
+
+    /* Skip the rest of the line */
+    while ((iHOSTLIST_EOF != iChar) && ('\n' != iChar))
+    {
+      iChar = hostlist_getc();
+    }
+  } while ((0 == uiLen) || ('#' == acHost[0]));
+
+  return true;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* hostlist_close()                                                           */
+/*----------------------------------------------------------------------------*/
+void hostlist_close(void)
+{
+  if (uiHOSTLIST_NO_HANDLE != g_tList.uiHandle)
+  {
+    esx_f_close(g_tList.uiHandle);
+    g_tList.uiHandle = uiHOSTLIST_NO_HANDLE;
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* hostlist_getc()                                                            */
+/*----------------------------------------------------------------------------*/
+static int hostlist_getc(void)
+{
+  if (g_tList.uiPos >= g_tList.uiLen)
+  {
+    uint16_t uiRead = esx_f_read(g_tList.uiHandle, g_tList.acBuffer, sizeof(g_tList.acBuffer));
+
+    if ((0 == uiRead) || (sizeof(g_tList.acBuffer) < uiRead))
+    {
+      return iHOSTLIST_EOF;
+    }
+
+    g_tList.uiPos = 0;
+    g_tList.uiLen = (uint8_t) uiRead;
+  }
+
+  return (uint8_t) g_tList.acBuffer[g_tList.uiPos++];
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* hostlist_blank()                                                           */
+/*----------------------------------------------------------------------------*/
+static bool hostlist_blank(int iChar)
+{
+  return ((' ' == iChar) || ('\t' == iChar));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
@@ -53,6 +53,22 @@
 #include "libzxn.h"
 #include "libuart.h"
 #include "libesp.h"
+#include "espbaud.h"
+#include "bankmem.h"
+#include "timer.h"
+#include "esprx.h"
+#include "atparse.h"
+#include "histo.h"
+#include "reclog.h"
+#include "dnscache.h"
+#include "dash.h"
+#include "monitor.h"
+#include "hostlist.h"
+#include "espready.h"
+#include "espcap.h"
+#include "udpecho.h"
+#include "statexp.h"
+#include "fmt.h"
 #include "ping.h"
 #include "version.h"
 
@@ -103,8 +119,8 @@ void _destruct(void);
 Application local "printf" that handels option "-q" ("quiet") and is able to
 print to stdout/stderr.
 @param pStream Stream to print to ("stdout", "stderr")
-@param acFmt Format string (see "printf")
-@return Errorcode (see "printf"); negative values signaling errors
+@param acFmt Format string (conversions see "fmt.h")
+@return Number of characters; negative values signaling errors
 */
 int app_printf(FILE* pStream, char_t* acFmt, ...);
 
@@ -133,6 +149,241 @@ Execute pings to given host
 */
 int ping(void);
 
+/*!
+Send one ping to each address of the given range (CIDR "a.b.c.d/n" or
+"a.b.c.d-e") and list the hosts that responded
+*/
+int sweep(void);
+
+/*!
+Ping all hosts of a host list ("-f") in one session of the ESP8266; a result
+line is printed per host and a summary of all hosts at the end
+*/
+int batch(void);
+
+/*!
+Send sequence-numbered probes to a UDP echo service ("-u"); up to five
+probes are in flight on the connections of the ESP8266 ("AT+CIPMUX=1"). The
+RTT is measured with the local clock.
+*/
+int echo(void);
+
+/*!
+Stream data to a TCP sink ("-t") for a fixed time or amount of data, in
+chunks of "AT+CIPSEND" or in passthrough mode ("-R"), and report the
+throughput and the send latency of the chunks
+*/
+int throughput(void);
+
+/*!
+Start the resident monitor (driver "pingmon.drv") for the given host
+*/
+int startMonitor(void);
+
+/*!
+Print the statistics of the resident monitor
+*/
+int showMonitor(void);
+
+/*!
+Stop the resident monitor and remove its driver
+*/
+int uninstallMonitor(void);
+
+/*!
+Initialize the UART and the ESP8266 (once). If the readiness record of the
+last run reports an idle ESP8266 and a quick "AT" is answered, the flush of
+the UART is skipped.
+*/
+void openEsp(void);
+
+/*!
+Restore the default baudrate, store the readiness record for the next run and
+release the UART (if "openEsp" was called)
+*/
+void closeEsp(void);
+
+/*!
+Prepare the ESP8266 for a series of pings (flush, baudrate)
+*/
+void openSession(void);
+
+/*!
+Send a command to the ESP8266; the command is recorded by "-C"
+@param acCmd Command (including CR/LF)
+@return EOK or errorcode of "esp_transmit"
+*/
+int transmitCommand(const char_t* acCmd);
+
+/*!
+Read the next byte received from the ESP8266 without waiting; the byte is
+recorded by "-C"
+@return Received byte; negative, if no byte is available
+*/
+int receiveByte(void);
+
+/*!
+Read the response of the ESP8266 to "AT+PING"; the duration of a successful
+ping is stored in "stats.uiTime". The keyboard is checked while waiting.
+@return Result of the ping (uiRECLOG_RESULT_xxx); uiRECLOG_RESULT_TIMEOUT if
+        the deadline ("-W") passed; uiRECLOG_RESULT_COMM if the ESP8266 did
+        not respond in time or sent "OK" without a time; uiPING_RESULT_BREAK
+        on a user break
+*/
+uint8_t receivePing(void);
+
+/*!
+Read the rest of the response to a ping that passed its deadline, so the
+ESP8266 accepts the next command. The keyboard is checked while waiting.
+@return "false" on a user break
+*/
+bool drainResponse(void);
+
+/*!
+Close the TCP connection of a ping with "-p"; a connect that passed its
+deadline is awaited before
+*/
+void closeConnection(void);
+
+/*!
+Wait for the prompt of "AT+CIPSEND" (">", not terminated by CR/LF)
+@return "true" if the prompt was received; "false" on "ERROR" or if the
+        ESP8266 did not respond in time
+*/
+bool waitPrompt(void);
+
+/*!
+Check the keyboard for a user break ("C", "Q", SPACE, BREAK)
+@return "true" if the user wants to stop
+*/
+bool userBreak(void);
+
+/*!
+Wait until the given time and check the keyboard every uiKEY_POLL ms
+@param uiDeadline End of the wait [ticks]
+@return "true" on a user break
+*/
+bool waitUntil(uint32_t uiDeadline);
+
+/*!
+Parse an IP address "a.b.c.d"
+@param acAddr Text starting with the address
+@param puiAddr Address
+@return Pointer behind the address; 0 if the text is no valid address
+*/
+char_t* parseAddress(const char_t* acAddr, uint32_t* puiAddr);
+
+/*!
+Parse an address range (CIDR "a.b.c.d/n" with n >= 16, or "a.b.c.d-e"); for
+n < 31 the network and broadcast addresses are excluded.
+@param acRange Address range
+@param puiFirst First address of the range
+@param puiLast Last address of the range
+@return "true" if the argument is a valid range
+*/
+bool parseRange(const char_t* acRange, uint32_t* puiFirst, uint32_t* puiLast);
+
+/*!
+Check if an argument is meant as range of the last octet: three octets of an
+address followed by a '-' (e.g. "192.168.1.250-3" or "192.168.1.x-y")
+@param acArg Argument
+@return "true" if the argument has the form of a range
+*/
+bool looksLikeRange(const char_t* acArg);
+
+/*!
+Switch the ESP8266 and the UART of the Next to another baudrate and check the
+connection by "AT"; if the check fails, both are switched back to the
+default baudrate.
+@param uiBaud Baudrate [bit/s]
+@return EOK; ENOTSUP if the baudrate is not usable
+*/
+int setBaudrate(uint32_t uiBaud);
+
+/*!
+Check the connection to the ESP8266 by "AT"
+@return "true" if the ESP8266 responded "OK"
+*/
+bool checkConnection(void);
+
+/*!
+Resolve the hostname once before the first ping, so the ESP8266 does not
+query the DNS server for each ping. The cache file is used, if possible.
+@return EOK; ERANGE if the host is unknown
+*/
+int resolveHost(void);
+
+/*!
+Read the next line of a response of the ESP8266 into "esp.acRxBuffer"; lines
+longer than the buffer are truncated, empty lines are skipped.
+@return AT_EVENT_NONE for lines without a special meaning, AT_EVENT_OK,
+        AT_EVENT_ERROR, ... for the final line of a response; AT_EVENT_FAIL
+        if the ESP8266 did not respond in time
+*/
+at_event_t readLine(void);
+
+/*!
+Read all lines of a response of the ESP8266 up to the final line
+@return AT_EVENT_OK, AT_EVENT_ERROR, ... (see "readLine")
+*/
+at_event_t readResponse(void);
+
+/*!
+Divide a number of bytes by a duration without overflow of 32 bits (for
+durations up to uiMAX_TEST_TIME)
+@param uiBytes Number of bytes
+@param uiMs Duration [ms]
+@return Bytes per second; 0 if the duration is 0
+*/
+uint32_t bytesPerSecond(uint32_t uiBytes, uint32_t uiMs);
+
+/*!
+Reset the statistical information before the first ping
+*/
+void resetStatistics(void);
+
+/*!
+Add the duration of the last successful ping ("stats.uiTime") to the
+statistical information
+*/
+void updateStatistics(void);
+
+/*!
+Add the phases of the last successful ping ("stats.auiStamp") to the
+statistical information
+*/
+void updatePhases(void);
+
+/*!
+Draw the column of the last ping into the live graph and update the counters
+of the dashboard (option "-d")
+@param bOk "true" if the last ping was answered
+*/
+void updateDashboard(bool bOk);
+
+/*!
+Returns the start of the next slot of a fixed probe rate (option "-r"). If
+the last ping overran its slot, the next ping starts immediately and is
+counted as late; slots that passed completely are counted as skipped.
+@param uiSlot Start of the slot of the last ping [ticks]
+@return Start of the slot of the next ping [ticks]
+*/
+uint32_t nextSlot(uint32_t uiSlot);
+
+/*!
+Write the final statistics and the exit code to the memory block ("-x")
+and/or to the integer variables of NextBASIC ("-X")
+*/
+void exportStatistics(void);
+
+/*!
+Check the thresholds of the service level ("-L", "-A", "-P")
+@param bFinal "true": check the statistics of all pings; "false": check if a
+       threshold is violated whatever the remaining pings of "-c" return
+@return EOK; ESLO_LOSS, ESLO_AVG or ESLO_P95 (in this order)
+*/
+int checkSlo(bool bFinal);
+
 /*============================================================================*/
 /*                               Klassen                                      */
 /*============================================================================*/
@@ -152,14 +403,62 @@ void _construct(void)
     g_tState.bQuiet     = false;
     g_tState.uiCount    = uiDEFAULT_COUNT;
     g_tState.uiInterval = uiDEFAULT_INTERVAL;
-    g_tState.acHost[0]  = '\0';
+    g_tState.bFixedRate = false;
+    g_tState.bFlood     = false;
+    g_tState.bDashboard = false;
+    g_tState.uiDeadline = 0;
+    g_tState.uiMaxLoss  = uiSLO_OFF;
+    g_tState.uiMaxAvg   = 0;
+    g_tState.uiMaxP95   = 0;
+    g_tState.bEarlyExit = false;
+    g_tState.uiEchoPort = 0;
+    g_tState.uiLinks    = uiDEFAULT_LINKS;
+    g_tState.uiTcpPort  = 0;
+    g_tState.uiTestPort = 0;
+    g_tState.uiChunk    = uiDEFAULT_CHUNK;
+    g_tState.uiTestTime = 0;
+    g_tState.uiTestKb   = 0;
+    g_tState.bPassthrough = false;
+    g_tState.bExport    = false;
+    g_tState.uiExportBank = uiSTATEXP_NO_BANK;
+    g_tState.uiExportAddr = 0;
+    g_tState.uiExportVar  = uiEXPORT_NO_VAR;
+    g_tState.bPending   = false;
+    g_tState.bMonitor   = false;
+    g_tState.bEspOpen   = false;
+    g_tState.bEspReady  = false;
+    g_tState.uiRxTimeout = uiESP_RX_TIMEOUT;
+    g_tState.uiBaud     = uiESPBAUD_DEFAULT;
+    g_tState.acAddr[0]  = '\0';
+    g_tState.acLogFile[0] = '\0';
+    g_tState.acListFile[0] = '\0';
+    g_tState.acCapFile[0] = '\0';
     g_tState.uiCpuSpeed = zxn_getspeed();
     g_tState.iExitCode  = EOK;
 
-    zxn_setspeed(RTM_28MHZ);
-    esp_open(&g_tState.tEsp);
+    /* Large buffers are kept in the resident page of the memory arena */
+    if ((EOK == bankmem_init()) &&
+        (0 != (g_tState.acHost         = bankmem_alloc(uiMAX_HOST_NAME))) &&
+        (0 != (g_tState.esp.acTxBuffer = bankmem_alloc(uiMAX_LEN_CMD))) &&
+        (0 != (g_tState.esp.acRxBuffer = bankmem_alloc(uiMAX_LEN_CMD))))
+    {
+      g_tState.acHost[0] = '\0';
+
+      /* The driver keeps away from the ESP8266 while this application runs;
+         "-M", "-m" and "-U" need it even if the ESP8266 is not opened */
+      g_tState.bMonitor = monitor_pause(true);
 
-    g_tState.bInitialized = true;
+      /* The ESP8266 is initialized by the actions that need it */
+      timer_init();
+      g_tState.uiLaunch = timer_now();
+
+      g_tState.bInitialized = true;
+    }
+    else
+    {
+      bankmem_exit();
+      g_tState.iExitCode = ENOMEM;
+    }
   }
 }
 
@@ -171,7 +470,20 @@ void _destruct(void)
 {
   if (g_tState.bInitialized)
   {
-    esp_close(&g_tState.tEsp);
+    reclog_close();
+    closeEsp();
+
+    if (g_tState.bMonitor)
+    {
+      monitor_pause(false);
+    }
+
+    timer_exit();
+    bankmem_exit();
+
+    /* The MMU slot of the arena is restored, so it may be written to */
+    exportStatistics();
+
     zxn_setspeed(g_tState.uiCpuSpeed);
   }
 }
@@ -185,7 +497,8 @@ int main(int argc, char* argv[])
   _construct();
   atexit(_destruct);
 
-  if (EOK == (g_tState.iExitCode = parseArguments(argc, argv)))
+  if ((EOK == g_tState.iExitCode) &&
+      (EOK == (g_tState.iExitCode = parseArguments(argc, argv))))
   {
     switch (g_tState.eAction)
     {
@@ -208,6 +521,34 @@ int main(int argc, char* argv[])
       case ACTION_PING:
         g_tState.iExitCode = ping();
         break;
+
+      case ACTION_SWEEP:
+        g_tState.iExitCode = sweep();
+        break;
+
+      case ACTION_BATCH:
+        g_tState.iExitCode = batch();
+        break;
+
+      case ACTION_ECHO:
+        g_tState.iExitCode = echo();
+        break;
+
+      case ACTION_THROUGHPUT:
+        g_tState.iExitCode = throughput();
+        break;
+
+      case ACTION_MONITOR:
+        g_tState.iExitCode = startMonitor();
+        break;
+
+      case ACTION_MONSTAT:
+        g_tState.iExitCode = showMonitor();
+        break;
+
+      case ACTION_UNINSTALL:
+        g_tState.iExitCode = uninstallMonitor();
+        break;
     }
   }
 
@@ -229,7 +570,7 @@ int app_printf(FILE* pStream, char_t* acFmt, ...)
       va_list args;
       va_start(args, acFmt);
 
-      iReturn = vfprintf(pStream, acFmt, args);
+      iReturn = fmt_vprint(pStream, acFmt, args);
 
       va_end(args);
     }
@@ -289,11 +630,11 @@ int parseArguments(int argc, char* argv[])
           break;
         }
       }
-      else if ((0 == strcmp(acArg, "-i")) || (0 == stricmp(acArg, "--interval")))
+      else if ((0 == strcmp(acArg, "-o")) || (0 == stricmp(acArg, "--output")))
       {
         if ((i + 1) < argc)
         {
-          g_tState.uiInterval = strtoul(argv[++i], 0, 0);
+          fmt_format(g_tState.acLogFile, sizeof(g_tState.acLogFile), "%s", argv[++i]);
         }
         else
         {
@@ -302,87 +643,553 @@ int parseArguments(int argc, char* argv[])
           break;
         }
       }
-      else
-      {
-        app_printf(stderr, "unknown option: %s\n", acArg);
-        iReturn = EINVAL;
-        break;
-      }
-    }
-    else /* Arguments */
-    {
-      if ('\0' == g_tState.acHost[0])
+      else if ((0 == strcmp(acArg, "-f")) || (0 == stricmp(acArg, "--file")))
       {
-        snprintf(g_tState.acHost, sizeof(g_tState.acHost), "%s", acArg);
+        if ((i + 1) < argc)
+        {
+          fmt_format(g_tState.acListFile, sizeof(g_tState.acListFile), "%s", argv[++i]);
+          g_tState.eAction = ACTION_BATCH;
+        }
+        else
+        {
+          app_printf(stderr, "option %s requires a value\n", acArg);
+          iReturn = EINVAL;
+          break;
+        }
       }
-      else
+      else if ((0 == strcmp(acArg, "-u")) || (0 == stricmp(acArg, "--udp")))
       {
-        app_printf(stderr, "unexpected extra argument: %s\n", acArg);
-        iReturn = EINVAL;
-        break;
-      }
-    }
+        if ((i + 1) < argc)
+        {
+          g_tState.uiEchoPort = strtoul(argv[++i], 0, 0);
 
-    ++i;
-  }
+          if (0 == g_tState.uiEchoPort)
+          {
+            app_printf(stderr, "invalid port: %s\n", argv[i]);
+            iReturn = EINVAL;
+            break;
+          }
 
-  if (EOK == iReturn)
-  {
-    if (ACTION_NONE == g_tState.eAction)
-    {
-      if ('\0' != g_tState.acHost[0])
-      {
-        g_tState.eAction = ACTION_PING;
+          g_tState.eAction = ACTION_ECHO;
+        }
+        else
+        {
+          app_printf(stderr, "option %s requires a value\n", acArg);
+          iReturn = EINVAL;
+          break;
+        }
       }
-      else
+      else if ((0 == strcmp(acArg, "-p")) || (0 == stricmp(acArg, "--port")))
       {
-        app_printf(stderr, "no hostname specified\n");
-        iReturn = EINVAL;
+        if ((i + 1) < argc)
+        {
+          g_tState.uiTcpPort = strtoul(argv[++i], 0, 0);
+
+          if (0 == g_tState.uiTcpPort)
+          {
+            app_printf(stderr, "invalid port: %s\n", argv[i]);
+            iReturn = EINVAL;
+            break;
+          }
+        }
+        else
+        {
+          app_printf(stderr, "option %s requires a value\n", acArg);
+          iReturn = EINVAL;
+          break;
+        }
       }
-    }
-  }
-
-  DBGPRINTF("parseargs() - action   = %d\n", g_tState.eAction);
-  DBGPRINTF("parseargs() - host     = %s\n", g_tState.acHost);
-  DBGPRINTF("parseargs() - count    = %u\n", g_tState.uiCount);
-  DBGPRINTF("parseargs() - interval = %u\n", g_tState.uiInterval);
+      else if ((0 == strcmp(acArg, "-t")) || (0 == stricmp(acArg, "--throughput")))
+      {
+        if ((i + 1) < argc)
+        {
+          g_tState.uiTestPort = strtoul(argv[++i], 0, 0);
 
-  return iReturn;
-}
+          if (0 == g_tState.uiTestPort)
+          {
+            app_printf(stderr, "invalid port: %s\n", argv[i]);
+            iReturn = EINVAL;
+            break;
+          }
 
+          g_tState.eAction = ACTION_THROUGHPUT;
+        }
+        else
+        {
+          app_printf(stderr, "option %s requires a value\n", acArg);
+          iReturn = EINVAL;
+          break;
+        }
+      }
+      else if ((0 == strcmp(acArg, "-s")) || (0 == stricmp(acArg, "--size")))
+      {
+        if ((i + 1) < argc)
+        {
+          uint32_t uiValue = strtoul(argv[++i], 0, 0);
 
-/*----------------------------------------------------------------------------*/
-/* showHelp()                                                                 */
-/*----------------------------------------------------------------------------*/
-int showHelp(void)
-{
-  char_t acAppName[0x10];
-  strncpy(acAppName, VER_INTERNALNAME_STR, sizeof(acAppName));
-  strupr(acAppName);
+          if ((0 == uiValue) || (uiMAX_CHUNK < uiValue))
+          {
+            app_printf(stderr, "invalid chunk size: %s\n", argv[i]);
+            iReturn = EINVAL;
+            break;
+          }
 
-  app_printf(stdout, "%s\n\n", VER_FILEDESCRIPTION_STR);
+          g_tState.uiChunk = (uint16_t) uiValue;
+        }
+        else
+        {
+          app_printf(stderr, "option %s requires a value\n", acArg);
+          iReturn = EINVAL;
+          break;
+        }
+      }
+      else if ((0 == strcmp(acArg, "-T")) /* || (0 == stricmp(acArg, "--Time")) */)
+      {
+        if ((i + 1) < argc)
+        {
+          uint32_t uiValue = strtoul(argv[++i], 0, 0);
 
-  app_printf(stdout, "%s host [-c x][-i x][-q][-h][-v][-V]\n\n", acAppName);
-  //                  0.........1.........2.........3.
-  app_printf(stdout, " host        host to ping\n");
-  app_printf(stdout, " -c[ount]    stop after x pings\n");
-  app_printf(stdout, " -i[nterval] delay betw. pings\n");
-  app_printf(stdout, " -q[uiet]    no screen output\n");
-  app_printf(stdout, " -h[elp]     print this help\n");
-  app_printf(stdout, " -v[ersion]  print version info\n");
-  app_printf(stdout, " -V[ersion]  print ext. version\n");
+          if ((0 == uiValue) || (uiMAX_TEST_TIME < uiValue))
+          {
+            app_printf(stderr, "invalid duration: %s\n", argv[i]);
+            iReturn = EINVAL;
+            break;
+          }
 
-  return EOK;
-}
+          g_tState.uiTestTime = (uint16_t) uiValue;
+        }
+        else
+        {
+          app_printf(stderr, "option %s requires a value\n", acArg);
+          iReturn = EINVAL;
+          break;
+        }
+      }
+      else if ((0 == strcmp(acArg, "-k")) || (0 == stricmp(acArg, "--kbytes")))
+      {
+        if ((i + 1) < argc)
+        {
+          uint32_t uiValue = strtoul(argv[++i], 0, 0);
 
+          if ((0 == uiValue) || (UINT16_MAX < uiValue))
+          {
+            app_printf(stderr, "invalid amount: %s\n", argv[i]);
+            iReturn = EINVAL;
+            break;
+          }
 
-/*----------------------------------------------------------------------------*/
-/* showInfo()                                                                 */
-/*----------------------------------------------------------------------------*/
-int showInfo(void)
-{
-  char_t acBuffer[0x10];
-  uint16_t uiVersion;
+          g_tState.uiTestKb = (uint16_t) uiValue;
+        }
+        else
+        {
+          app_printf(stderr, "option %s requires a value\n", acArg);
+          iReturn = EINVAL;
+          break;
+        }
+      }
+      else if ((0 == strcmp(acArg, "-R")) /* || (0 == stricmp(acArg, "--Raw")) */)
+      {
+        g_tState.bPassthrough = true;
+      }
+      else if ((0 == strcmp(acArg, "-x")) || (0 == stricmp(acArg, "--export")))
+      {
+        if ((i + 1) < argc)
+        {
+          char_t* acNext;
+          uint32_t uiValue = strtoul(argv[++i], &acNext, 0);
+
+          if (',' == *acNext) /* bank,offset */
+          {
+            uint32_t uiOffset = strtoul(acNext + 1, 0, 0);
+
+            if ((uiSTATEXP_MAX_BANK < uiValue) || ((0x4000 - sizeof(statexp_t)) < uiOffset))
+            {
+              app_printf(stderr, "invalid address: %s\n", argv[i]);
+              iReturn = EINVAL;
+              break;
+            }
+
+            g_tState.uiExportBank = (uint8_t) uiValue;
+            g_tState.uiExportAddr = (uint16_t) uiOffset;
+          }
+          else
+          {
+            /* Main memory, not the dot command or the ROM */
+            if ((0x4000 > uiValue) || ((0x10000 - sizeof(statexp_t)) < uiValue))
+            {
+              app_printf(stderr, "invalid address: %s\n", argv[i]);
+              iReturn = EINVAL;
+              break;
+            }
+
+            g_tState.uiExportBank = uiSTATEXP_NO_BANK;
+            g_tState.uiExportAddr = (uint16_t) uiValue;
+          }
+
+          g_tState.bExport = true;
+        }
+        else
+        {
+          app_printf(stderr, "option %s requires a value\n", acArg);
+          iReturn = EINVAL;
+          break;
+        }
+      }
+      else if ((0 == strcmp(acArg, "-X")) /* || (0 == stricmp(acArg, "--Export")) */)
+      {
+        if ((i + 1) < argc)
+        {
+          char_t cVar = (char_t) (argv[++i][0] | 0x20); /* "R" = "r" */
+
+          if (('a' > cVar) || (('z' + 1 - uiSTATEXP_VARS) < cVar) || ('\0' != argv[i][1]))
+          {
+            app_printf(stderr, "invalid variable: %s\n", argv[i]);
+            iReturn = EINVAL;
+            break;
+          }
+
+          g_tState.uiExportVar = (uint8_t) (cVar - 'a');
+        }
+        else
+        {
+          app_printf(stderr, "option %s requires a value\n", acArg);
+          iReturn = EINVAL;
+          break;
+        }
+      }
+      else if ((0 == strcmp(acArg, "-n")) || (0 == stricmp(acArg, "--links")))
+      {
+        if ((i + 1) < argc)
+        {
+          uint32_t uiValue = strtoul(argv[++i], 0, 0);
+
+          if ((0 == uiValue) || (uiUDPECHO_LINKS < uiValue))
+          {
+            app_printf(stderr, "invalid number of links: %s\n", argv[i]);
+            iReturn = EINVAL;
+            break;
+          }
+
+          g_tState.uiLinks = (uint8_t) uiValue;
+        }
+        else
+        {
+          app_printf(stderr, "option %s requires a value\n", acArg);
+          iReturn = EINVAL;
+          break;
+        }
+      }
+      else if ((0 == strcmp(acArg, "-C")) || (0 == stricmp(acArg, "--capture")))
+      {
+        if ((i + 1) < argc)
+        {
+          fmt_format(g_tState.acCapFile, sizeof(g_tState.acCapFile), "%s", argv[++i]);
+        }
+        else
+        {
+          app_printf(stderr, "option %s requires a value\n", acArg);
+          iReturn = EINVAL;
+          break;
+        }
+      }
+      else if ((0 == strcmp(acArg, "-b")) || (0 == stricmp(acArg, "--baud")))
+      {
+        if ((i + 1) < argc)
+        {
+          g_tState.uiBaud = strtoul(argv[++i], 0, 0);
+
+          if ((g_tState.uiBaud < uiESPBAUD_DEFAULT) || (g_tState.uiBaud > 4000000UL))
+          {
+            app_printf(stderr, "invalid baudrate: %s\n", argv[i]);
+            iReturn = EINVAL;
+            break;
+          }
+        }
+        else
+        {
+          app_printf(stderr, "option %s requires a value\n", acArg);
+          iReturn = EINVAL;
+          break;
+        }
+      }
+      else if ((0 == strcmp(acArg, "-r")) || (0 == stricmp(acArg, "--rate")))
+      {
+        g_tState.bFixedRate = true;
+      }
+      else if ((0 == strcmp(acArg, "-F")) || (0 == stricmp(acArg, "--flood")))
+      {
+        g_tState.bFlood = true;
+      }
+      else if ((0 == strcmp(acArg, "-d")) || (0 == stricmp(acArg, "--dashboard")))
+      {
+        g_tState.bDashboard = true;
+      }
+      else if ((0 == strcmp(acArg, "-M")) || (0 == stricmp(acArg, "--monitor")))
+      {
+        g_tState.eAction = ACTION_MONITOR;
+      }
+      else if ((0 == strcmp(acArg, "-m")) || (0 == stricmp(acArg, "--monstat")))
+      {
+        g_tState.eAction = ACTION_MONSTAT;
+      }
+      else if ((0 == strcmp(acArg, "-U")) /* || (0 == stricmp(acArg, "--Uninstall")) */)
+      {
+        g_tState.eAction = ACTION_UNINSTALL;
+      }
+      else if ((0 == strcmp(acArg, "-L")) || (0 == stricmp(acArg, "--loss")))
+      {
+        if ((i + 1) < argc)
+        {
+          uint32_t uiValue = strtoul(argv[++i], 0, 0);
+
+          if (100 < uiValue)
+          {
+            app_printf(stderr, "invalid loss: %s\n", argv[i]);
+            iReturn = EINVAL;
+            break;
+          }
+
+          g_tState.uiMaxLoss = (uint8_t) uiValue;
+        }
+        else
+        {
+          app_printf(stderr, "option %s requires a value\n", acArg);
+          iReturn = EINVAL;
+          break;
+        }
+      }
+      else if ((0 == strcmp(acArg, "-A")) || (0 == stricmp(acArg, "--avg")))
+      {
+        if ((i + 1) < argc)
+        {
+          g_tState.uiMaxAvg = strtoul(argv[++i], 0, 0);
+        }
+        else
+        {
+          app_printf(stderr, "option %s requires a value\n", acArg);
+          iReturn = EINVAL;
+          break;
+        }
+      }
+      else if ((0 == strcmp(acArg, "-P")) || (0 == stricmp(acArg, "--p95")))
+      {
+        if ((i + 1) < argc)
+        {
+          g_tState.uiMaxP95 = strtoul(argv[++i], 0, 0);
+        }
+        else
+        {
+          app_printf(stderr, "option %s requires a value\n", acArg);
+          iReturn = EINVAL;
+          break;
+        }
+      }
+      else if ((0 == strcmp(acArg, "-E")) || (0 == stricmp(acArg, "--early")))
+      {
+        g_tState.bEarlyExit = true;
+      }
+      else if ((0 == strcmp(acArg, "-W")) || (0 == stricmp(acArg, "--deadline")))
+      {
+        if ((i + 1) < argc)
+        {
+          g_tState.uiDeadline = strtoul(argv[++i], 0, 0);
+        }
+        else
+        {
+          app_printf(stderr, "option %s requires a value\n", acArg);
+          iReturn = EINVAL;
+          break;
+        }
+      }
+      else if ((0 == strcmp(acArg, "-i")) || (0 == stricmp(acArg, "--interval")))
+      {
+        if ((i + 1) < argc)
+        {
+          g_tState.uiInterval = strtoul(argv[++i], 0, 0);
+        }
+        else
+        {
+          app_printf(stderr, "option %s requires a value\n", acArg);
+          iReturn = EINVAL;
+          break;
+        }
+      }
+      else
+      {
+        app_printf(stderr, "unknown option: %s\n", acArg);
+        iReturn = EINVAL;
+        break;
+      }
+    }
+    else /* Arguments */
+    {
+      if ('\0' == g_tState.acHost[0])
+      {
+        fmt_format(g_tState.acHost, uiMAX_HOST_NAME, "%s", acArg);
+      }
+      else
+      {
+        app_printf(stderr, "unexpected extra argument: %s\n", acArg);
+        iReturn = EINVAL;
+        break;
+      }
+    }
+
+    ++i;
+  }
+
+  if (EOK == iReturn)
+  {
+    if (ACTION_NONE == g_tState.eAction)
+    {
+      if ('\0' != g_tState.acHost[0])
+      {
+        uint32_t uiFirst;
+        uint32_t uiLast;
+
+        if (parseRange(g_tState.acHost, &uiFirst, &uiLast))
+        {
+          g_tState.eAction = ACTION_SWEEP;
+        }
+        else if ((0 != strchr(g_tState.acHost, '/')) || looksLikeRange(g_tState.acHost))
+        {
+          app_printf(stderr, "invalid range: %s\n", g_tState.acHost);
+          iReturn = EINVAL;
+        }
+        else
+        {
+          g_tState.eAction = ACTION_PING;
+        }
+      }
+      else
+      {
+        app_printf(stderr, "no hostname specified\n");
+        iReturn = EINVAL;
+      }
+    }
+    else if (((ACTION_MONITOR == g_tState.eAction) || (ACTION_ECHO == g_tState.eAction) ||
+              (ACTION_THROUGHPUT == g_tState.eAction)) &&
+             ('\0' == g_tState.acHost[0]))
+    {
+      app_printf(stderr, "no hostname specified\n");
+      iReturn = EINVAL;
+    }
+    else if ((ACTION_BATCH == g_tState.eAction) && ('\0' != g_tState.acHost[0]))
+    {
+      app_printf(stderr, "unexpected extra argument: %s\n", g_tState.acHost);
+      iReturn = EINVAL;
+    }
+    else if ((ACTION_BATCH == g_tState.eAction) &&
+             ((0 != g_tState.uiTcpPort) || g_tState.bFlood || g_tState.bDashboard ||
+              ('\0' != g_tState.acLogFile[0]) || g_tState.bFixedRate ||
+              (uiSLO_OFF != g_tState.uiMaxLoss) || (0 != g_tState.uiMaxAvg) ||
+              (0 != g_tState.uiMaxP95) || g_tState.bEarlyExit))
+    {
+      /* batch() pings each host by "AT+PING" and prints one line per host */
+      app_printf(stderr, "-p -F -d -o -r -L -A -P -E not with -f\n");
+      iReturn = EINVAL;
+    }
+
+    if ((ACTION_THROUGHPUT == g_tState.eAction) && (0 == g_tState.uiTestTime))
+    {
+      /* "-k" alone ends after uiMAX_TEST_TIME at the latest */
+      g_tState.uiTestTime = (0 != g_tState.uiTestKb ? uiMAX_TEST_TIME : uiDEFAULT_TEST_TIME);
+    }
+  }
+
+  DBGPRINTF("parseargs() - action   = %d\n", g_tState.eAction);
+  DBGPRINTF("parseargs() - host     = %s\n", g_tState.acHost);
+  DBGPRINTF("parseargs() - count    = %u\n", g_tState.uiCount);
+  DBGPRINTF("parseargs() - interval = %u\n", g_tState.uiInterval);
+  DBGPRINTF("parseargs() - deadline = %u\n", g_tState.uiDeadline);
+  DBGPRINTF("parseargs() - slo      = %u%%/%u/%u\n", g_tState.uiMaxLoss, g_tState.uiMaxAvg, g_tState.uiMaxP95);
+  DBGPRINTF("parseargs() - rate     = %d\n", g_tState.bFixedRate);
+  DBGPRINTF("parseargs() - flood    = %d\n", g_tState.bFlood);
+  DBGPRINTF("parseargs() - dash     = %d\n", g_tState.bDashboard);
+  DBGPRINTF("parseargs() - output   = %s\n", g_tState.acLogFile);
+  DBGPRINTF("parseargs() - list     = %s\n", g_tState.acListFile);
+  DBGPRINTF("parseargs() - udp      = %u/%u\n", g_tState.uiEchoPort, g_tState.uiLinks);
+  DBGPRINTF("parseargs() - tcp      = %u\n", g_tState.uiTcpPort);
+  DBGPRINTF("parseargs() - test     = %u/%u/%u/%u/%d\n", g_tState.uiTestPort, g_tState.uiChunk, g_tState.uiTestTime, g_tState.uiTestKb, g_tState.bPassthrough);
+  DBGPRINTF("parseargs() - export   = %u/%u/%u\n", g_tState.uiExportBank, g_tState.uiExportAddr, g_tState.uiExportVar);
+  DBGPRINTF("parseargs() - capture  = %s\n", g_tState.acCapFile);
+  DBGPRINTF("parseargs() - baud     = %lu\n", (unsigned long) g_tState.uiBaud);
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* showHelp()                                                                 */
+/*----------------------------------------------------------------------------*/
+int showHelp(void)
+{
+  char_t acAppName[0x10];
+  strncpy(acAppName, VER_INTERNALNAME_STR, sizeof(acAppName));
+  strupr(acAppName);
+
+  app_printf(stdout, "%s\n\n", VER_FILEDESCRIPTION_STR);
+
+  //                  0.........1.........2.........3.
+  app_printf(stdout, "%s host [-p x][-c x][-i x]\n", acAppName);
+  app_printf(stdout, "     [-W x][-L x][-A x][-P x]\n");
+  app_printf(stdout, "     [-E][-r][-F][-d][-M]\n");
+  app_printf(stdout, "     [-o f][-C f][-x a][-X v]\n");
+  app_printf(stdout, "     [-b x][-q][-h][-v][-V]\n");
+  app_printf(stdout, "%s -f f [-c x][-i x][-W x]\n", acAppName);
+  app_printf(stdout, "%s host -u x [-n x][-c x]\n", acAppName);
+  app_printf(stdout, "     [-i x][-W x]\n");
+  app_printf(stdout, "%s host -t x [-s x][-T x]\n", acAppName);
+  app_printf(stdout, "     [-k x][-R]\n");
+  app_printf(stdout, "%s -m|-U\n\n", acAppName);
+
+  //                  0.........1.........2.........3.
+  app_printf(stdout, " host        host to ping\n");
+  app_printf(stdout, "             or a.b.c.d/n\n");
+  app_printf(stdout, "             or a.b.c.d-e\n");
+  app_printf(stdout, " -p[ort]     tcp connect port x\n");
+  app_printf(stdout, " -c[ount]    stop after x pings\n");
+  app_printf(stdout, " -i[nterval] delay betw. pings\n");
+  app_printf(stdout, " -W          deadline per ping\n");
+  app_printf(stdout, " -L[oss]     max. loss (%%)\n");
+  app_printf(stdout, " -A[vg]      max. avg. rtt (ms)\n");
+  app_printf(stdout, " -P[95]      max. p95 rtt (ms)\n");
+  app_printf(stdout, " -E[arly]    stop on -L/-A/-P\n");
+  app_printf(stdout, " -r[ate]     -i start to start\n");
+  app_printf(stdout, " -F[lood]    no delay, '.'/ping\n");
+  app_printf(stdout, " -d[ashbrd]  live latency graph\n");
+  app_printf(stdout, " -f[ile]     ping hosts in f\n");
+  app_printf(stdout, " -u[dp]      udp echo to port x\n");
+  app_printf(stdout, " -n          udp probes at once\n");
+  app_printf(stdout, " -t[hruput]  tcp sink at port x\n");
+  app_printf(stdout, " -s[ize]     chunk size (bytes)\n");
+  app_printf(stdout, " -T          test duration (s)\n");
+  app_printf(stdout, " -k[bytes]   test amount (KB)\n");
+  app_printf(stdout, " -R          passthrough mode\n");
+  app_printf(stdout, " -M[onitor]  ping in background\n");
+  app_printf(stdout, " -m[onstat]  background stats\n");
+  app_printf(stdout, " -U          stop -M, uninstall\n");
+  app_printf(stdout, " -o[utput]   log results to f\n");
+  app_printf(stdout, " -C[apture]  log UART to f\n");
+  app_printf(stdout, " -x          stats to a|bank,ofs\n");
+  app_printf(stdout, " -X          stats to %%v..%%v+6\n");
+  app_printf(stdout, " -b[aud]     UART speed (bit/s)\n");
+  app_printf(stdout, " -q[uiet]    no screen output\n");
+  app_printf(stdout, " -h[elp]     print this help\n");
+  app_printf(stdout, " -v[ersion]  print version info\n");
+  app_printf(stdout, " -V[ersion]  print ext. version\n");
+
+  return EOK;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* showInfo()                                                                 */
+/*----------------------------------------------------------------------------*/
+int showInfo(void)
+{
+  char_t acBuffer[0x10];
+  uint16_t uiVersion;
 
   strncpy(acBuffer, VER_INTERNALNAME_STR, sizeof(acBuffer));
   strupr(acBuffer);
@@ -391,7 +1198,7 @@ int showInfo(void)
 
   if (ESX_DOSVERSION_NEXTOS_48K != (uiVersion = esx_m_dosversion()))
   {
-    snprintf(acBuffer, sizeof(acBuffer), "NextOS %u.%02u",
+    fmt_format(acBuffer, sizeof(acBuffer), "NextOS %u.%02u",
              ESX_DOSVERSION_NEXTOS_MAJOR(uiVersion),
              ESX_DOSVERSION_NEXTOS_MINOR(uiVersion));
   }
@@ -420,13 +1227,12 @@ int showInfoEx(void)
 
   app_printf(stdout, "%s: Espressif ESP8266\n", acBuffer);
 
-  /* Initialize UART/ESP */
-  esp_flush(&g_tState.tEsp);
+  openEsp();
 
   /* Read version information */
-  if (EOK == esp_transmit(&g_tState.tEsp, sCMD_AT_GMR "\r\n"))
+  if (EOK == transmitCommand(sCMD_AT_GMR "\r\n"))
   {
-    while (ESP_LINE_DATA == esp_receive_ex(&g_tState.tEsp, g_tState.esp.acRxBuffer, sizeof(g_tState.esp.acRxBuffer)))
+    while (AT_EVENT_NONE == readLine())
     {
       zxn_rtrim(g_tState.esp.acRxBuffer);
       app_printf(stdout, " %s\n", g_tState.esp.acRxBuffer);
@@ -438,9 +1244,9 @@ int showInfoEx(void)
   }
 
   /* Read local IP addresses */
-  if (EOK == esp_transmit(&g_tState.tEsp, sCMD_AT_CIPSTA_CUR "?" "\r\n"))
+  if (EOK == transmitCommand(sCMD_AT_CIPSTA_CUR "?" "\r\n"))
   {
-    while (ESP_LINE_DATA == esp_receive_ex(&g_tState.tEsp, g_tState.esp.acRxBuffer, sizeof(g_tState.esp.acRxBuffer)))
+    while (AT_EVENT_NONE == readLine())
     {
       zxn_rtrim(g_tState.esp.acRxBuffer);
       app_printf(stdout, " %s\n", g_tState.esp.acRxBuffer);
@@ -451,6 +1257,11 @@ int showInfoEx(void)
     app_printf(stderr, "unable to send " sCMD_AT_CIPSTA_CUR " to ESP8266\n");
   }
 
+  app_printf(stdout, " UART RX: max. %u/%u bytes, %u lost\n",
+                      esprx_stats()->uiHighWater,
+                      uiESPRX_RING_SIZE,
+                      esprx_stats()->uiOverruns);
+
   return EOK;
 }
 
@@ -461,33 +1272,108 @@ int showInfoEx(void)
 int ping(void)
 {
   int iReturn = EOK;
+  int iSlo = EOK;
+  int iFile;
   uint8_t uiResult;
+  uint32_t uiSlot;
+  uint32_t uiStart;
+  uint32_t uiProbe = 0;
+  uint32_t uiFailed = 0;
 
-  /* Initialize UART/ESP */
-  esp_flush(&g_tState.tEsp);
+  openSession();
+  resetStatistics();
+
+  /* Resolve hostname */
+  if (EOK != (iReturn = resolveHost()))
+  {
+    app_printf(stderr, "unknown host \"%s\"\n", g_tState.acHost);
+    goto EXIT_PING;
+  }
 
-  /* Create PING command */
-  snprintf(g_tState.esp.acTxBuffer, sizeof(g_tState.esp.acTxBuffer), sCMD_AT_PING "=\"%s\"\r\n", g_tState.acHost);
+  /* Create PING command ("-p": TCP connect) */
+  if (0 != g_tState.uiTcpPort)
+  {
+    fmt_format(g_tState.esp.acTxBuffer, uiMAX_LEN_CMD, sCMD_AT_CIPSTART "=\"TCP\",\"%s\",%u\r\n",
+               ('\0' != g_tState.acAddr[0] ? g_tState.acAddr : g_tState.acHost),
+               g_tState.uiTcpPort);
+  }
+  else
+  {
+    fmt_format(g_tState.esp.acTxBuffer, uiMAX_LEN_CMD, sCMD_AT_PING "=\"%s\"\r\n",
+             ('\0' != g_tState.acAddr[0] ? g_tState.acAddr : g_tState.acHost));
+  }
 
 #if 0
   putchar(0x04);
   putchar(0x00);
 #endif
 
-  app_printf(stdout, "pinging %s ..\n", g_tState.acHost);
-
-  g_tState.stats.uiTotal = 0;
-  g_tState.stats.uiTime  = 0;
-  g_tState.stats.uiMin   = UINT16_MAX;
-  g_tState.stats.uiMax   = 0;
-  g_tState.stats.uiPings = 0;
-  g_tState.stats.uiPongs = 0;
-
-  bool bFinished = false;
+  if (0 != g_tState.uiTcpPort)
+  {
+    app_printf(stdout, "connecting to %s port %u ..\n",
+                        ('\0' != g_tState.acAddr[0] ? g_tState.acAddr : g_tState.acHost),
+                        g_tState.uiTcpPort);
+  }
+  else if ('\0' != g_tState.acAddr[0])
+  {
+    app_printf(stdout, "pinging %s (%s) ..\n", g_tState.acHost, g_tState.acAddr);
+  }
+  else
+  {
+    app_printf(stdout, "pinging %s ..\n", g_tState.acHost);
+  }
+
+  if ('\0' != g_tState.acLogFile[0])
+  {
+    if (EOK != (iReturn = reclog_open(g_tState.acLogFile, g_tState.uiInterval, g_tState.bFixedRate)))
+    {
+      app_printf(stderr, "unable to open \"%s\"\n", g_tState.acLogFile);
+      goto EXIT_PING;
+    }
+  }
+
+  if (g_tState.bDashboard)
+  {
+    dash_init();
+  }
+
+  uiStart = uiSlot = timer_now();
+
+  bool bFinished = false;
   do
   {
+    /* A ping that passed its deadline is still processed by the ESP8266 */
+    if (g_tState.bPending)
+    {
+      uiProbe = timer_now();
+      bFinished = !drainResponse();
+      uiFailed += timer_now() - uiProbe;
+
+      if (bFinished)
+      {
+        break;
+      }
+    }
+
+    if (g_tState.bFlood)
+    {
+      uiProbe = timer_now();
+
+      if (!g_tState.bDashboard)
+      {
+        app_printf(stdout, ".");
+      }
+    }
+
     /* Send request to ESP8266 */
-    if (EOK == esp_transmit(&g_tState.tEsp, g_tState.esp.acTxBuffer))
+    g_tState.stats.auiStamp[STAMP_TX_START] = timer_now();
+
+    if (0 == g_tState.stats.uiPings)
+    {
+      g_tState.stats.uiStartup = (uint16_t) TIMER_TICKS_TO_MS(g_tState.stats.auiStamp[STAMP_TX_START] - g_tState.uiLaunch);
+    }
+
+    if (EOK == transmitCommand(g_tState.esp.acTxBuffer))
     {
       ++g_tState.stats.uiPings;
     }
@@ -497,74 +1383,123 @@ int ping(void)
       goto EXIT_PING;
     }
 
-    /* Read response from ESP8266 */
-    for ( ; ; )
+    g_tState.stats.auiStamp[STAMP_TX_DONE] = timer_now();
+
+    /* Read response from ESP8266; a user break stops before the summary */
+    if (uiPING_RESULT_BREAK == (uiResult = receivePing()))
     {
-      uiResult = esp_receive_ex(&g_tState.tEsp, g_tState.esp.acRxBuffer, sizeof(g_tState.esp.acRxBuffer));  
+      --g_tState.stats.uiPings;
 
-      if (ESP_LINE_DATA == uiResult)
+      if (0 != g_tState.uiTcpPort)
       {
-        sscanf(g_tState.esp.acRxBuffer, "+%u", &g_tState.stats.uiTime);
+        closeConnection();
       }
-      else if (ESP_LINE_OK == uiResult)
-      {
-        ++g_tState.stats.uiPongs;
+      break;
+    }
 
-        g_tState.stats.uiTotal += g_tState.stats.uiTime;
+    switch (uiResult)
+    {
+      case uiRECLOG_RESULT_OK:
+        updateStatistics();
 
-        if (g_tState.stats.uiTime < g_tState.stats.uiMin)
+        if (g_tState.bFlood)
         {
-          g_tState.stats.uiMin = g_tState.stats.uiTime;
+          if (!g_tState.bDashboard)
+          {
+            app_printf(stdout, "\b");
+          }
         }
+        else if (g_tState.bDashboard)
+        {
+          /* Graph only */
+        }
+        else if (0 != g_tState.uiTcpPort)
+        {
+          app_printf(stdout, "connect to %s port %u: time=%u ms\n", g_tState.acHost, g_tState.uiTcpPort, g_tState.stats.uiTime);
+        }
+        else
+        {
+          app_printf(stdout, "response from %s: time=%u ms\n", g_tState.acHost, g_tState.stats.uiTime);
+        }
+        break;
 
-        if (g_tState.stats.uiTime > g_tState.stats.uiMax)
+      case uiRECLOG_RESULT_BUSY:
+        if (!g_tState.bFlood && !g_tState.bDashboard)
         {
-          g_tState.stats.uiMax = g_tState.stats.uiTime;
+          app_printf(stdout, "busy\n");
         }
+        break;
 
-        app_printf(stdout, "response from %s: time=%u ms\n", g_tState.acHost, g_tState.stats.uiTime);
+      case uiRECLOG_RESULT_TIMEOUT:
+        if (!g_tState.bFlood && !g_tState.bDashboard)
+        {
+          app_printf(stdout, "timeout\n");
+        }
         break;
-      }
-      else if (ESP_LINE_ERROR == uiResult)
-      {
-        app_printf(stderr, "unknown host \"%s\"\n", g_tState.acHost);
-        iReturn = ERANGE;
-        goto EXIT_PING;
-      }
-      else if (ESP_LINE_FAIL == uiResult)
-      {
-        app_printf(stdout, "timeout\n");
+
+      case uiRECLOG_RESULT_ERROR:
+        if (0 != g_tState.uiTcpPort)
+        {
+          /* Refused or unreachable: the service is down, not the host */
+          if (!g_tState.bFlood && !g_tState.bDashboard)
+          {
+            app_printf(stdout, "connect failed\n");
+          }
+        }
+        else
+        {
+          app_printf(stderr, "unknown host \"%s\"\n", g_tState.acHost);
+          iReturn = ERANGE;
+        }
         break;
-      }
-      else
-      {
+
+      default: /* uiRECLOG_RESULT_COMM */
         app_printf(stderr, "communication error\n");
         iReturn = ENOTSUP;
-        goto EXIT_PING;
-      }
+        break;
     }
 
-    /* User break ? */
-    if (0 != (g_tState.iKey = in_inkey()))
+    /* Flood mode: time of failed pings is not part of the overhead */
+    if (g_tState.bFlood && (uiRECLOG_RESULT_OK != uiResult))
     {
-      switch (g_tState.iKey)
-      {
-        case ' ':
-        case 'c':
-        case 'C':
-        case 'q':
-        case 'Q':
-          bFinished = true;
-          break;
-      }
+      uiFailed += timer_now() - uiProbe;
     }
 
-   #if 0
-    if (in_key_pressed(IN_KEY_SCANCODE_SPACE | 0x8000)) /* CAPS + SPACE */
+    /* Log result */
+    if (EOK != (iFile = reclog_add(g_tState.stats.uiPings,
+                                   (uiRECLOG_RESULT_OK == uiResult ? g_tState.stats.uiTime : 0),
+                                   uiResult)))
     {
-      bFinished = true;
-    } 
-   #endif
+      app_printf(stderr, "unable to write \"%s\"\n", g_tState.acLogFile);
+      iReturn = (EOK != iReturn ? iReturn : iFile);
+    }
+
+    if (EOK != iReturn)
+    {
+      goto EXIT_PING;
+    }
+
+    if (g_tState.bDashboard)
+    {
+      updateDashboard(uiRECLOG_RESULT_OK == uiResult);
+    }
+
+    if (uiRECLOG_RESULT_OK == uiResult)
+    {
+      g_tState.stats.auiStamp[STAMP_LOCAL_DONE] = timer_now();
+      updatePhases();
+    }
+
+    if (0 != g_tState.uiTcpPort)
+    {
+      closeConnection();
+    }
+
+    /* User break ? (flood mode: not for every ping) */
+    if (!g_tState.bFlood || (0 == (g_tState.stats.uiPings & (uiFLOOD_KEY_CHECK - 1))))
+    {
+      bFinished = userBreak();
+    }
 
     /* Count reached ? */
     if (0 != g_tState.uiCount)
@@ -575,10 +1510,25 @@ int ping(void)
       }
     }
 
+    /* Threshold violated, whatever the remaining pings return ? */
+    if (g_tState.bEarlyExit && !bFinished && (EOK != checkSlo(false)))
+    {
+      app_printf(stdout, "slo violated, stopping\n");
+      bFinished = true;
+    }
+
     /* Interval */
-    if ((0 != g_tState.uiInterval) && !bFinished)
+    if ((0 != g_tState.uiInterval) && !g_tState.bFlood && !bFinished)
     {
-      zxn_sleep_ms(g_tState.uiInterval);
+      if (g_tState.bFixedRate)
+      {
+        uiSlot = nextSlot(uiSlot);
+        bFinished = waitUntil(uiSlot);
+      }
+      else
+      {
+        bFinished = waitUntil(timer_now() + TIMER_MS_TO_TICKS(g_tState.uiInterval));
+      }
     }
   }
   while (!bFinished);
@@ -591,8 +1541,97 @@ int ping(void)
                       ((uint16_t) g_tState.stats.uiTotal));
   app_printf(stdout, "rtt min/avg/max = %u/%u/%u [ms]\n",
                       (UINT16_MAX != g_tState.stats.uiMin ? g_tState.stats.uiMin : 0),
-                      ((uint16_t) (g_tState.stats.uiTotal / g_tState.stats.uiPongs)),
+                      (0 != g_tState.stats.uiPongs ? ((uint16_t) (g_tState.stats.uiTotal / g_tState.stats.uiPongs)) : 0),
                       g_tState.stats.uiMax);
+  app_printf(stdout, "rtt p50/p90/p99 = %u/%u/%u [ms]\n",
+                      histo_percentile(&g_tState.stats.tHisto, 50),
+                      histo_percentile(&g_tState.stats.tHisto, 90),
+                      histo_percentile(&g_tState.stats.tHisto, 99));
+  app_printf(stdout, "rtt mdev = %u [ms]\n", histo_mdev(&g_tState.stats.tHisto));
+
+  if (0 != g_tState.stats.uiPongs)
+  {
+    static const char_t* const acPhase[PHASE_COUNT] = { "uart tx", "esp    ", "network", "uart rx", "local  " };
+    uint8_t i;
+
+    app_printf(stdout, "phase min/avg/max [ms]\n");
+
+    for (i = 0; i < PHASE_COUNT; ++i)
+    {
+      uint16_t uiAvg = (uint16_t) (g_tState.stats.atPhase[i].uiTotal / g_tState.stats.uiPongs);
+
+      app_printf(stdout, " %s  %u.%u/%u.%u/%u.%u\n", acPhase[i],
+                          g_tState.stats.atPhase[i].uiMin / 10, g_tState.stats.atPhase[i].uiMin % 10,
+                          uiAvg / 10, uiAvg % 10,
+                          g_tState.stats.atPhase[i].uiMax / 10, g_tState.stats.atPhase[i].uiMax % 10);
+    }
+  }
+
+  if ('\0' != g_tState.acAddr[0])
+  {
+    app_printf(stdout, "dns %u ms%s\n",
+                        g_tState.stats.uiResolve,
+                        (g_tState.stats.bCached ? " (cache)" : ""));
+  }
+
+  app_printf(stdout, "startup %u ms%s\n",
+                      g_tState.stats.uiStartup,
+                      (g_tState.bEspReady ? " (esp ready)" : ""));
+
+  if ((uiSLO_OFF != g_tState.uiMaxLoss) || (0 != g_tState.uiMaxAvg) || (0 != g_tState.uiMaxP95))
+  {
+    switch (iSlo = checkSlo(true))
+    {
+      case ESLO_LOSS:
+        app_printf(stdout, "slo violated: loss > %u%%\n", g_tState.uiMaxLoss);
+        break;
+
+      case ESLO_AVG:
+        app_printf(stdout, "slo violated: avg > %u ms\n", g_tState.uiMaxAvg);
+        break;
+
+      case ESLO_P95:
+        app_printf(stdout, "slo violated: p95 > %u ms\n", g_tState.uiMaxP95);
+        break;
+
+      default:
+        app_printf(stdout, "slo met\n");
+        break;
+    }
+  }
+
+  if (0 != esprx_stats()->uiOverruns)
+  {
+    app_printf(stderr, "%u bytes lost on UART\n", esprx_stats()->uiOverruns);
+  }
+
+  if (g_tState.bFlood && (0 != g_tState.stats.uiPings))
+  {
+    uint32_t uiElapsed  = TIMER_TICKS_TO_100US(timer_now() - uiStart);
+    uint32_t uiRtt      = g_tState.stats.uiTotal * uiTIMER_TICKS_PER_MS;
+    uint16_t uiPeriod   = (uint16_t) (uiElapsed / g_tState.stats.uiPings);
+    uint32_t uiRate     = (0 != uiPeriod ? (100000UL / uiPeriod) : 0);
+    uint16_t uiOverhead = 0;
+
+    /* [100 us]: time per successful ping minus the RTT reported by ESP8266 */
+    uiElapsed -= TIMER_TICKS_TO_100US(uiFailed);
+
+    if ((0 != g_tState.stats.uiPongs) && (uiElapsed > uiRtt))
+    {
+      uiOverhead = (uint16_t) ((uiElapsed - uiRtt) / g_tState.stats.uiPongs);
+    }
+
+    app_printf(stdout, "%u.%u pings/s, overhead %u.%u ms/ping\n",
+                        (uint16_t) (uiRate / 10), (uint16_t) (uiRate % 10),
+                        uiOverhead / 10, uiOverhead % 10);
+  }
+
+  if (g_tState.bFixedRate)
+  {
+    app_printf(stdout, "%u late, %u skipped slots\n",
+                        g_tState.stats.uiLate,
+                        g_tState.stats.uiSkipped);
+  }
 
   /* Wait until break-key is released */
   while (0 != (g_tState.iKey = in_inkey()))
@@ -602,15 +1641,1988 @@ int ping(void)
 
 EXIT_PING:
 
+  if (EOK != (iFile = reclog_close()))
+  {
+    app_printf(stderr, "unable to write \"%s\"\n", g_tState.acLogFile);
+    iReturn = (EOK != iReturn ? iReturn : iFile);
+  }
+
 #if 0
   putchar(0x04);
   putchar(0x01);
 #endif
 
+  if (EOK != iReturn)
+  {
+    return iReturn;
+  }
+
+  if (EOK != iSlo)
+  {
+    return iSlo;
+  }
+
+  return (0 != g_tState.stats.uiPongs ? EOK : ETIMEOUT);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* sweep()                                                                    */
+/*----------------------------------------------------------------------------*/
+int sweep(void)
+{
+  int iReturn = EOK;
+  uint8_t auiUp[0x20];
+  uint8_t uiResult;
+  uint8_t uiRetry;
+  uint16_t uiRow;
+  uint8_t i;
+  uint32_t uiFirst;
+  uint32_t uiLast;
+  uint32_t uiAddr;
+  uint32_t uiStart;
+  bool bMap;
+
+  parseRange(g_tState.acHost, &uiFirst, &uiLast);
+
+  /* Map of the last octet, if the range is part of one /24 network */
+  bMap = ((uiFirst >> 8) == (uiLast >> 8));
+  memset(auiUp, 0, sizeof(auiUp));
+
+  openSession();
+  resetStatistics();
+
+  app_printf(stdout, "sweeping %s ..\n", g_tState.acHost);
+
+  uiStart = timer_now();
+
+  for (uiAddr = uiFirst; ; ++uiAddr)
+  {
+    fmt_format(g_tState.acAddr, sizeof(g_tState.acAddr), "%u.%u.%u.%u",
+             (uint8_t) (uiAddr >> 24), (uint8_t) (uiAddr >> 16), (uint8_t) (uiAddr >> 8), (uint8_t) uiAddr);
+    fmt_format(g_tState.esp.acTxBuffer, uiMAX_LEN_CMD, sCMD_AT_PING "=\"%s\"\r\n", g_tState.acAddr);
+
+    /* One ping per host; a dropped request ("busy") is repeated */
+    uiRetry = 3;
+    do
+    {
+      if (g_tState.bPending && !drainResponse())
+      {
+        uiResult = uiPING_RESULT_BREAK;
+        break;
+      }
+
+      g_tState.stats.auiStamp[STAMP_TX_START] = timer_now();
+
+      if (EOK != transmitCommand(g_tState.esp.acTxBuffer))
+      {
+        iReturn = EBREAK;
+        goto EXIT_SWEEP;
+      }
+
+      uiResult = receivePing();
+    }
+    while ((uiRECLOG_RESULT_BUSY == uiResult) && (0 != --uiRetry));
+
+    if (uiPING_RESULT_BREAK == uiResult)
+    {
+      --uiAddr;
+      break;
+    }
+
+    ++g_tState.stats.uiPings;
+
+    if (uiRECLOG_RESULT_OK == uiResult)
+    {
+      updateStatistics();
+      auiUp[((uint8_t) uiAddr) >> 3] |= (1 << (uiAddr & 0x07));
+      app_printf(stdout, "%s: time=%u ms\n", g_tState.acAddr, g_tState.stats.uiTime);
+    }
+    else if (uiRECLOG_RESULT_COMM == uiResult)
+    {
+      app_printf(stderr, "communication error\n");
+      iReturn = ENOTSUP;
+      goto EXIT_SWEEP;
+    }
+
+    if (userBreak() || (uiAddr == uiLast))
+    {
+      break;
+    }
+  }
+
+  /* Table of all hosts: '#' = up, '.' = down */
+  if (bMap)
+  {
+    app_printf(stdout, "\n    0123456789ABCDEF\n");
+
+    for (uiRow = (uint8_t) (uiFirst & 0xF0); uiRow <= (uint8_t) uiLast; uiRow += 0x10)
+    {
+      for (i = 0; i < 0x10; ++i)
+      {
+        g_tState.esp.acRxBuffer[i] = ((((uint8_t) uiFirst) > (uiRow + i)) || (((uint8_t) uiAddr) < (uiRow + i)))
+                                     ? ' '
+                                     : ((auiUp[(uiRow + i) >> 3] & (1 << (i & 0x07))) ? '#' : '.');
+      }
+
+      g_tState.esp.acRxBuffer[0x10] = '\0';
+      app_printf(stdout, "%3u %s\n", uiRow, g_tState.esp.acRxBuffer);
+    }
+  }
+
+  /* Create statistics */
+  app_printf(stdout, "\n--- %s sweep ---\n", g_tState.acHost);
+  app_printf(stdout, "%u hosts, %u up, %u down\n",
+                      g_tState.stats.uiPings,
+                      g_tState.stats.uiPongs,
+                      g_tState.stats.uiPings - g_tState.stats.uiPongs);
+  app_printf(stdout, "time %lu ms\n", (unsigned long) TIMER_TICKS_TO_MS(timer_now() - uiStart));
+  app_printf(stdout, "rtt min/avg/max = %u/%u/%u [ms]\n",
+                      (UINT16_MAX != g_tState.stats.uiMin ? g_tState.stats.uiMin : 0),
+                      (0 != g_tState.stats.uiPongs ? ((uint16_t) (g_tState.stats.uiTotal / g_tState.stats.uiPongs)) : 0),
+                      g_tState.stats.uiMax);
+
+  /* Wait until break-key is released */
+  while (0 != (g_tState.iKey = in_inkey()))
+  {
+    intrinsic_nop();
+  }
+
+EXIT_SWEEP:
+
+  g_tState.acAddr[0] = '\0';
+
   return (EOK != iReturn ? iReturn : (0 != g_tState.stats.uiPongs ? EOK : ETIMEOUT));
 }
 
 
+/*----------------------------------------------------------------------------*/
+/* batch()                                                                    */
+/*----------------------------------------------------------------------------*/
+int batch(void)
+{
+  int iReturn;
+  uint8_t uiResult;
+  uint16_t uiCount;
+  uint16_t uiHosts = 0;
+  uint16_t uiUp    = 0;
+  uint16_t uiSent  = 0;
+  uint16_t uiRcvd  = 0;
+  uint16_t uiMin   = UINT16_MAX;
+  uint16_t uiMax   = 0;
+  uint32_t uiTotal = 0;
+  uint32_t uiStart;
+  bool bFirst    = true;
+  bool bFinished = false;
+
+  if (EOK != (iReturn = hostlist_open(g_tState.acListFile)))
+  {
+    app_printf(stderr, "unable to open \"%s\"\n", g_tState.acListFile);
+    return iReturn;
+  }
+
+  openSession();
+
+  app_printf(stdout, "pinging hosts of %s ..\n", g_tState.acListFile);
+  //                  0.........1.........2.........3.
+  app_printf(stdout, "sent rcvd loss   avg host\n");
+
+  uiStart = timer_now();
+
+  while (!bFinished && hostlist_next(g_tState.acHost, uiMAX_HOST_NAME, &uiCount))
+  {
+    /* Count of the list, else "-c"; endless pings make no sense here */
+    if (0 == uiCount)
+    {
+      uiCount = (0 != g_tState.uiCount ? g_tState.uiCount : uiDEFAULT_COUNT);
+    }
+
+    ++uiHosts;
+    resetStatistics();
+
+    if (EOK != resolveHost())
+    {
+      app_printf(stdout, "   -    -    -     - %s unknown\n", g_tState.acHost);
+      continue;
+    }
+
+    fmt_format(g_tState.esp.acTxBuffer, uiMAX_LEN_CMD, sCMD_AT_PING "=\"%s\"\r\n",
+             ('\0' != g_tState.acAddr[0] ? g_tState.acAddr : g_tState.acHost));
+
+    while (g_tState.stats.uiPings < uiCount)
+    {
+      /* Interval between all pings of the batch, not only of one host */
+      if ((0 != g_tState.uiInterval) && !bFirst &&
+          waitUntil(timer_now() + TIMER_MS_TO_TICKS(g_tState.uiInterval)))
+      {
+        bFinished = true;
+        break;
+      }
+
+      bFirst = false;
+
+      if (g_tState.bPending && !drainResponse())
+      {
+        bFinished = true;
+        break;
+      }
+
+      g_tState.stats.auiStamp[STAMP_TX_START] = timer_now();
+
+      if (EOK != transmitCommand(g_tState.esp.acTxBuffer))
+      {
+        iReturn = EBREAK;
+        goto EXIT_BATCH;
+      }
+
+      ++g_tState.stats.uiPings;
+
+      if (uiPING_RESULT_BREAK == (uiResult = receivePing()))
+      {
+        --g_tState.stats.uiPings;
+        bFinished = true;
+        break;
+      }
+
+      if (uiRECLOG_RESULT_OK == uiResult)
+      {
+        updateStatistics();
+      }
+      else if (uiRECLOG_RESULT_ERROR == uiResult)
+      {
+        /* Host unknown to the ESP8266: further pings fail as well */
+        break;
+      }
+      else if (uiRECLOG_RESULT_COMM == uiResult)
+      {
+        app_printf(stderr, "communication error\n");
+        iReturn = ENOTSUP;
+        goto EXIT_BATCH;
+      }
+
+      if (userBreak())
+      {
+        bFinished = true;
+        break;
+      }
+    }
+
+    /* Result line of the host */
+    if (0 != g_tState.stats.uiPings)
+    {
+      uint16_t uiLoss = (uint16_t) ((100UL * (g_tState.stats.uiPings - g_tState.stats.uiPongs)) / g_tState.stats.uiPings);
+
+      if (0 != g_tState.stats.uiPongs)
+      {
+        app_printf(stdout, "%4u %4u %3u%% %5u %s\n",
+                            g_tState.stats.uiPings,
+                            g_tState.stats.uiPongs,
+                            uiLoss,
+                            (uint16_t) (g_tState.stats.uiTotal / g_tState.stats.uiPongs),
+                            g_tState.acHost);
+      }
+      else
+      {
+        app_printf(stdout, "%4u %4u %3u%%     - %s\n",
+                            g_tState.stats.uiPings,
+                            g_tState.stats.uiPongs,
+                            uiLoss,
+                            g_tState.acHost);
+      }
+    }
+
+    /* Summary of all hosts */
+    uiSent  += g_tState.stats.uiPings;
+    uiRcvd  += g_tState.stats.uiPongs;
+    uiTotal += g_tState.stats.uiTotal;
+
+    if (0 != g_tState.stats.uiPongs)
+    {
+      ++uiUp;
+    }
+
+    if (g_tState.stats.uiMin < uiMin)
+    {
+      uiMin = g_tState.stats.uiMin;
+    }
+
+    if (g_tState.stats.uiMax > uiMax)
+    {
+      uiMax = g_tState.stats.uiMax;
+    }
+  }
+
+  /* Create statistics */
+  app_printf(stdout, "\n--- %s batch ---\n", g_tState.acListFile);
+  app_printf(stdout, "%u hosts, %u up, %u down\n", uiHosts, uiUp, uiHosts - uiUp);
+  app_printf(stdout, "%u transmitted, %u received, time %lu ms\n",
+                      uiSent,
+                      uiRcvd,
+                      (unsigned long) TIMER_TICKS_TO_MS(timer_now() - uiStart));
+  app_printf(stdout, "rtt min/avg/max = %u/%u/%u [ms]\n",
+                      (UINT16_MAX != uiMin ? uiMin : 0),
+                      (0 != uiRcvd ? ((uint16_t) (uiTotal / uiRcvd)) : 0),
+                      uiMax);
+
+  if (0 != esprx_stats()->uiOverruns)
+  {
+    app_printf(stderr, "%u bytes lost on UART\n", esprx_stats()->uiOverruns);
+  }
+
+  /* Wait until break-key is released */
+  while (0 != (g_tState.iKey = in_inkey()))
+  {
+    intrinsic_nop();
+  }
+
+EXIT_BATCH:
+
+  hostlist_close();
+  g_tState.acAddr[0] = '\0';
+
+  return (EOK != iReturn ? iReturn : ((0 != uiHosts) && (uiUp == uiHosts) ? EOK : ETIMEOUT));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* echo()                                                                     */
+/*----------------------------------------------------------------------------*/
+int echo(void)
+{
+  int iReturn = EOK;
+  int iByte;
+  udpecho_parser_t tParser;
+  udpecho_event_t eEvent;
+  echolink_t atLink[uiUDPECHO_LINKS];
+  uint8_t auiAnswered[0x100 / 8];    /* bitmap of the last 256 sequence numbers */
+  uint8_t uiLink;
+  uint8_t uiSending  = UINT8_MAX;    /* link of the pending "AT+CIPSEND"        */
+  uint8_t uiInFlight = 0;
+  uint16_t uiSeq     = 0;            /* sequence number of the next probe       */
+  uint16_t uiHighest = 0;            /* highest sequence number answered + 1    */
+  uint16_t uiReordered  = 0;
+  uint16_t uiDuplicates = 0;
+  uint16_t uiLateReplies = 0;
+  uint32_t uiTimeout = TIMER_MS_TO_TICKS(0 != g_tState.uiDeadline ? g_tState.uiDeadline : uiECHO_TIMEOUT);
+  uint32_t uiNow;
+  uint32_t uiStart;
+  uint32_t uiNext;
+  uint32_t uiKey;
+  uint32_t uiCommand = 0;
+  bool bFinished = false;
+
+  openSession();
+  resetStatistics();
+
+  if (EOK != (iReturn = resolveHost()))
+  {
+    app_printf(stderr, "unknown host \"%s\"\n", g_tState.acHost);
+    return iReturn;
+  }
+
+  /* Multiple connections, one UDP connection per probe in flight */
+  if ((EOK != transmitCommand(sCMD_AT_CIPMUX "=1\r\n")) || (AT_EVENT_OK != readResponse()))
+  {
+    app_printf(stderr, "multiple connections not supported\n");
+    return ENOTSUP;
+  }
+
+  for (uiLink = 0; uiLink < g_tState.uiLinks; ++uiLink)
+  {
+    fmt_format(g_tState.esp.acTxBuffer, uiMAX_LEN_CMD, sCMD_AT_CIPSTART "=%u,\"UDP\",\"%s\",%u,%u,0\r\n",
+               uiLink,
+               ('\0' != g_tState.acAddr[0] ? g_tState.acAddr : g_tState.acHost),
+               g_tState.uiEchoPort,
+               uiECHO_LOCAL_PORT + uiLink);
+
+    if ((EOK != transmitCommand(g_tState.esp.acTxBuffer)) || (AT_EVENT_OK != readResponse()))
+    {
+      app_printf(stderr, "unable to open udp link %u\n", uiLink);
+      iReturn = ENOTSUP;
+      goto EXIT_ECHO;
+    }
+
+    atLink[uiLink].bBusy = false;
+  }
+
+  memset(auiAnswered, 0, sizeof(auiAnswered));
+  udpecho_reset(&tParser);
+
+  if ('\0' != g_tState.acAddr[0])
+  {
+    app_printf(stdout, "udp echo %s (%s) port %u, %u links ..\n",
+                        g_tState.acHost, g_tState.acAddr, g_tState.uiEchoPort, g_tState.uiLinks);
+  }
+  else
+  {
+    app_printf(stdout, "udp echo %s port %u, %u links ..\n",
+                        g_tState.acHost, g_tState.uiEchoPort, g_tState.uiLinks);
+  }
+
+  uiStart = timer_now();
+  uiNext  = uiStart;
+  uiKey   = uiStart + TIMER_MS_TO_TICKS(uiKEY_POLL);
+
+  while (!bFinished || (0 != uiInFlight) || (UINT8_MAX != uiSending))
+  {
+    uiNow = timer_now();
+
+    /* Next probe: the ESP8266 accepts one "AT+CIPSEND" at a time */
+    if (!bFinished && (UINT8_MAX == uiSending) && (uiInFlight < g_tState.uiLinks) &&
+        !TIMER_BEFORE(uiNow, uiNext))
+    {
+      for (uiLink = 0; atLink[uiLink].bBusy; ++uiLink)
+      {
+        intrinsic_nop();
+      }
+
+      fmt_format(g_tState.esp.acTxBuffer, uiMAX_LEN_CMD, sCMD_AT_CIPSEND "=%u,%u\r\n",
+                 uiLink, uiUDPECHO_PROBE_LEN);
+
+      if (EOK != transmitCommand(g_tState.esp.acTxBuffer))
+      {
+        iReturn = EBREAK;
+        goto EXIT_ECHO;
+      }
+
+      uiSending = uiLink;
+      uiCommand = uiNow;
+      uiNext    = uiNow + TIMER_MS_TO_TICKS(g_tState.uiInterval);
+    }
+
+    if (0 > (iByte = receiveByte()))
+    {
+      /* Probes without reply */
+      for (uiLink = 0; uiLink < g_tState.uiLinks; ++uiLink)
+      {
+        if (atLink[uiLink].bBusy && ((uiNow - atLink[uiLink].uiStamp) > uiTimeout))
+        {
+          atLink[uiLink].bBusy = false;
+          --uiInFlight;
+
+          if (!g_tState.bFlood)
+          {
+            app_printf(stdout, "seq=%u timeout\n", atLink[uiLink].uiSeq);
+          }
+        }
+      }
+
+      if ((UINT8_MAX != uiSending) && ((uiNow - uiCommand) > TIMER_MS_TO_TICKS(uiESP_RX_TIMEOUT)))
+      {
+        app_printf(stderr, "communication error\n");
+        iReturn = ENOTSUP;
+        goto EXIT_ECHO;
+      }
+
+      if (TIMER_BEFORE(uiKey, uiNow))
+      {
+        if (userBreak())
+        {
+          /* Replies of the probes in flight are not awaited */
+          break;
+        }
+
+        uiKey = uiNow + TIMER_MS_TO_TICKS(uiKEY_POLL);
+      }
+
+      continue;
+    }
+
+    eEvent = udpecho_parse(&tParser, (uint8_t) iByte);
+
+    if (UDPECHO_EVENT_PROMPT == eEvent)
+    {
+      if (UINT8_MAX != uiSending)
+      {
+        echolink_t* pLink = &atLink[uiSending];
+
+        pLink->uiSeq = uiSeq++;
+        fmt_format(g_tState.esp.acTxBuffer, uiMAX_LEN_CMD, "P%05u", pLink->uiSeq);
+
+        if (EOK != transmitCommand(g_tState.esp.acTxBuffer))
+        {
+          iReturn = EBREAK;
+          goto EXIT_ECHO;
+        }
+
+        /* The probe leaves the ESP8266 with the last byte of its data */
+        pLink->uiStamp = timer_now();
+        pLink->bBusy   = true;
+        ++uiInFlight;
+
+        auiAnswered[(pLink->uiSeq & 0xFF) >> 3] &= ~(1 << (pLink->uiSeq & 0x07));
+        ++g_tState.stats.uiPings;
+
+        if ((0 != g_tState.uiCount) && (g_tState.stats.uiPings >= g_tState.uiCount))
+        {
+          bFinished = true;
+        }
+      }
+    }
+    else if (UDPECHO_EVENT_SEND_OK == eEvent)
+    {
+      uiSending = UINT8_MAX;
+    }
+    else if ((UDPECHO_EVENT_SEND_FAIL == eEvent) || (UDPECHO_EVENT_ERROR == eEvent))
+    {
+      if (UINT8_MAX != uiSending)
+      {
+        if (!atLink[uiSending].bBusy)
+        {
+          /* "AT+CIPSEND" rejected: the connection is gone */
+          app_printf(stderr, "unable to send on udp link %u\n", uiSending);
+          iReturn = ENOTSUP;
+          goto EXIT_ECHO;
+        }
+
+        /* The probe is lost; the link is free again */
+        atLink[uiSending].bBusy = false;
+        --uiInFlight;
+        uiSending = UINT8_MAX;
+      }
+    }
+    else if (UDPECHO_EVENT_BUSY == eEvent)
+    {
+      /* Command is dropped; the probe is sent again */
+      uiSending = UINT8_MAX;
+    }
+    else if ((UDPECHO_EVENT_DATA == eEvent) && tParser.bProbe &&
+             (((uint16_t) (uiSeq - tParser.uiSeq - 1)) < 0x100))
+    {
+      uint8_t* pAnswered = &auiAnswered[(tParser.uiSeq & 0xFF) >> 3];
+      uint8_t  uiMask    = (uint8_t) (1 << (tParser.uiSeq & 0x07));
+      bool bReordered    = ((int16_t) (tParser.uiSeq - uiHighest) < 0);
+
+      uiLink = tParser.uiLink;
+
+      if (0 != (*pAnswered & uiMask))
+      {
+        ++uiDuplicates;
+      }
+      else if ((uiLink < g_tState.uiLinks) && atLink[uiLink].bBusy && (atLink[uiLink].uiSeq == tParser.uiSeq))
+      {
+        uint32_t uiRtt = TIMER_TICKS_TO_100US(timer_now() - atLink[uiLink].uiStamp);
+
+        *pAnswered |= uiMask;
+        atLink[uiLink].bBusy = false;
+        --uiInFlight;
+
+        /* [100 us] */
+        g_tState.stats.uiTime = (uint16_t) (uiRtt < UINT16_MAX ? uiRtt : UINT16_MAX);
+        updateStatistics();
+
+        if (bReordered)
+        {
+          ++uiReordered;
+        }
+        else
+        {
+          uiHighest = tParser.uiSeq + 1;
+        }
+
+        if (!g_tState.bFlood)
+        {
+          app_printf(stdout, "seq=%u link=%u time=%u.%u ms%s\n",
+                              tParser.uiSeq, uiLink,
+                              g_tState.stats.uiTime / 10, g_tState.stats.uiTime % 10,
+                              (bReordered ? " (reordered)" : ""));
+        }
+      }
+      else
+      {
+        /* Reply after the timeout of its probe */
+        *pAnswered |= uiMask;
+        ++uiLateReplies;
+      }
+    }
+  }
+
+  /* Create statistics */
+  app_printf(stdout, "\n--- %s:%u udp echo ---\n", g_tState.acHost, g_tState.uiEchoPort);
+  app_printf(stdout, "%u transmitted, %u received, time %lu ms\n",
+                      g_tState.stats.uiPings,
+                      g_tState.stats.uiPongs,
+                      (unsigned long) TIMER_TICKS_TO_MS(timer_now() - uiStart));
+
+  if (0 != g_tState.stats.uiPongs)
+  {
+    uint16_t uiMin = g_tState.stats.uiMin;
+    uint16_t uiAvg = (uint16_t) (g_tState.stats.uiTotal / g_tState.stats.uiPongs);
+    uint16_t uiMax = g_tState.stats.uiMax;
+    uint16_t auiPercentile[3];
+
+    auiPercentile[0] = histo_percentile(&g_tState.stats.tHisto, 50);
+    auiPercentile[1] = histo_percentile(&g_tState.stats.tHisto, 90);
+    auiPercentile[2] = histo_percentile(&g_tState.stats.tHisto, 99);
+
+    app_printf(stdout, "rtt min/avg/max = %u.%u/%u.%u/%u.%u [ms]\n",
+                        uiMin / 10, uiMin % 10, uiAvg / 10, uiAvg % 10, uiMax / 10, uiMax % 10);
+    app_printf(stdout, "rtt p50/p90/p99 = %u.%u/%u.%u/%u.%u [ms]\n",
+                        auiPercentile[0] / 10, auiPercentile[0] % 10,
+                        auiPercentile[1] / 10, auiPercentile[1] % 10,
+                        auiPercentile[2] / 10, auiPercentile[2] % 10);
+  }
+
+  app_printf(stdout, "%u reordered, %u duplicates, %u late\n", uiReordered, uiDuplicates, uiLateReplies);
+
+  if (0 != g_tState.stats.uiPings)
+  {
+    uint32_t uiElapsed = TIMER_TICKS_TO_100US(timer_now() - uiStart);
+    uint32_t uiRate    = (0 != uiElapsed ? ((100000UL * g_tState.stats.uiPings) / uiElapsed) : 0);
+
+    app_printf(stdout, "%u.%u probes/s\n", (uint16_t) (uiRate / 10), (uint16_t) (uiRate % 10));
+  }
+
+  if (0 != esprx_stats()->uiOverruns)
+  {
+    app_printf(stderr, "%u bytes lost on UART\n", esprx_stats()->uiOverruns);
+  }
+
+  /* Wait until break-key is released */
+  while (0 != (g_tState.iKey = in_inkey()))
+  {
+    intrinsic_nop();
+  }
+
+EXIT_ECHO:
+
+  /* Close all connections ("5" = all) and leave the multiple connections */
+  if (EOK == transmitCommand(sCMD_AT_CIPCLOSE "=5\r\n"))
+  {
+    readResponse();
+  }
+
+  if (EOK == transmitCommand(sCMD_AT_CIPMUX "=0\r\n"))
+  {
+    readResponse();
+  }
+
+  g_tState.acAddr[0] = '\0';
+
+  return (EOK != iReturn ? iReturn : (0 != g_tState.stats.uiPongs ? EOK : ETIMEOUT));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* throughput()                                                               */
+/*----------------------------------------------------------------------------*/
+int throughput(void)
+{
+  int iReturn = EOK;
+  at_event_t eEvent;
+  char_t cPattern;
+  uint16_t uiLen;
+  uint16_t uiPiece;
+  uint16_t uiSent;
+  uint16_t i;
+  uint32_t uiBytes    = 0;           /* bytes accepted by the ESP8266          */
+  uint32_t uiInterval = 0;           /* bytes of the current report interval   */
+  uint32_t uiLimit    = ((uint32_t) g_tState.uiTestKb) << 10;
+  uint32_t uiStart;
+  uint32_t uiEnd;
+  uint32_t uiReport;
+  uint32_t uiChunk;
+  uint32_t uiNow;
+  uint32_t uiElapsed;
+  bool bStreaming = false;
+
+  openSession();
+  resetStatistics();
+
+  if (EOK != (iReturn = resolveHost()))
+  {
+    app_printf(stderr, "unknown host \"%s\"\n", g_tState.acHost);
+    return iReturn;
+  }
+
+  fmt_format(g_tState.esp.acTxBuffer, uiMAX_LEN_CMD, sCMD_AT_CIPSTART "=\"TCP\",\"%s\",%u\r\n",
+             ('\0' != g_tState.acAddr[0] ? g_tState.acAddr : g_tState.acHost),
+             g_tState.uiTestPort);
+
+  if ((EOK != transmitCommand(g_tState.esp.acTxBuffer)) || (AT_EVENT_OK != readResponse()))
+  {
+    app_printf(stderr, "connect failed\n");
+    iReturn = ETIMEOUT;
+    goto EXIT_THROUGHPUT;
+  }
+
+  /* Passthrough: the ESP8266 sends all bytes of the UART until "+++" */
+  if (g_tState.bPassthrough)
+  {
+    if ((EOK != transmitCommand(sCMD_AT_CIPMODE "=1\r\n")) || (AT_EVENT_OK != readResponse()) ||
+        (EOK != transmitCommand(sCMD_AT_CIPSEND "\r\n")) || !waitPrompt())
+    {
+      app_printf(stderr, "passthrough mode not supported\n");
+      iReturn = ENOTSUP;
+      goto EXIT_THROUGHPUT;
+    }
+
+    bStreaming = true;
+  }
+
+  app_printf(stdout, "sending to %s port %u, %u byte chunks (%s) ..\n",
+                      ('\0' != g_tState.acAddr[0] ? g_tState.acAddr : g_tState.acHost),
+                      g_tState.uiTestPort,
+                      g_tState.uiChunk,
+                      (g_tState.bPassthrough ? "passthrough" : "cipsend"));
+
+  uiStart  = timer_now();
+  uiEnd    = uiStart + TIMER_MS_TO_TICKS(1000UL * g_tState.uiTestTime);
+  uiReport = uiStart + TIMER_MS_TO_TICKS(1000);
+
+  for ( ; ; )
+  {
+    uiNow = timer_now();
+
+    if (((0 != uiLimit) && (uiBytes >= uiLimit)) || !TIMER_BEFORE(uiNow, uiEnd) || userBreak())
+    {
+      break;
+    }
+
+    uiLen = g_tState.uiChunk;
+
+    if ((0 != uiLimit) && ((uiLimit - uiBytes) < uiLen))
+    {
+      uiLen = (uint16_t) (uiLimit - uiBytes);
+    }
+
+    ++g_tState.stats.uiPings;
+    uiChunk = uiNow;
+
+    if (!g_tState.bPassthrough)
+    {
+      fmt_format(g_tState.esp.acTxBuffer, uiMAX_LEN_CMD, sCMD_AT_CIPSEND "=%u\r\n", uiLen);
+
+      if ((EOK != transmitCommand(g_tState.esp.acTxBuffer)) || !waitPrompt())
+      {
+        app_printf(stderr, "connection closed\n");
+        iReturn = ENOTSUP;
+        break;
+      }
+    }
+
+    /* Data: "0123456789..." in pieces of the size of the command buffer */
+    for (i = 0, cPattern = '0'; i < (uiMAX_LEN_CMD - 1); ++i)
+    {
+      g_tState.esp.acTxBuffer[i] = cPattern;
+      cPattern = ('9' == cPattern ? '0' : cPattern + 1);
+    }
+
+    for (uiSent = 0; uiSent < uiLen; uiSent += uiPiece)
+    {
+      uiPiece = uiLen - uiSent;
+      uiPiece = (uiPiece < (uiMAX_LEN_CMD - 1) ? uiPiece : (uiMAX_LEN_CMD - 1));
+
+      cPattern = g_tState.esp.acTxBuffer[uiPiece];
+      g_tState.esp.acTxBuffer[uiPiece] = '\0';
+
+      if (EOK != transmitCommand(g_tState.esp.acTxBuffer))
+      {
+        iReturn = EBREAK;
+        goto EXIT_THROUGHPUT;
+      }
+
+      g_tState.esp.acTxBuffer[uiPiece] = cPattern;
+    }
+
+    /* "AT+CIPSEND": the chunk is done with "SEND OK"; passthrough: with the
+       transfer over the UART */
+    if (!g_tState.bPassthrough)
+    {
+      while (AT_EVENT_NONE == (eEvent = readLine()))
+      {
+        if ((0 == strncmp(g_tState.esp.acRxBuffer, "SEND OK", 7)) ||
+            (0 == strncmp(g_tState.esp.acRxBuffer, "SEND FAIL", 9)))
+        {
+          break;
+        }
+      }
+
+      if (AT_EVENT_NONE != eEvent)
+      {
+        app_printf(stderr, "communication error\n");
+        iReturn = ENOTSUP;
+        break;
+      }
+
+      if ('F' == g_tState.esp.acRxBuffer[5])
+      {
+        /* Chunk lost */
+        continue;
+      }
+    }
+
+    uiNow = timer_now();
+
+    /* [100 us] */
+    uiElapsed = TIMER_TICKS_TO_100US(uiNow - uiChunk);
+    g_tState.stats.uiTime = (uint16_t) (uiElapsed < UINT16_MAX ? uiElapsed : UINT16_MAX);
+    updateStatistics();
+
+    uiBytes    += uiLen;
+    uiInterval += uiLen;
+
+    /* One line per second */
+    if (!TIMER_BEFORE(uiNow, uiReport))
+    {
+      uiElapsed = TIMER_TICKS_TO_MS(uiNow - uiReport) + 1000;
+
+      app_printf(stdout, "%lu s: %lu bytes, %lu kbit/s\n",
+                          (unsigned long) TIMER_TICKS_TO_MS(uiNow - uiStart) / 1000,
+                          (unsigned long) uiInterval,
+                          (unsigned long) ((8 * bytesPerSecond(uiInterval, uiElapsed)) / 1000));
+
+      uiInterval = 0;
+      uiReport   = uiNow + TIMER_MS_TO_TICKS(1000);
+    }
+  }
+
+  uiElapsed = TIMER_TICKS_TO_MS(timer_now() - uiStart);
+
+  /* Create statistics */
+  app_printf(stdout, "\n--- %s:%u throughput ---\n", g_tState.acHost, g_tState.uiTestPort);
+  app_printf(stdout, "%lu bytes in %lu ms, %u of %u chunks sent\n",
+                      (unsigned long) uiBytes,
+                      (unsigned long) uiElapsed,
+                      g_tState.stats.uiPongs,
+                      g_tState.stats.uiPings);
+  app_printf(stdout, "%lu bytes/s, %lu kbit/s (uart %lu bytes/s)\n",
+                      (unsigned long) bytesPerSecond(uiBytes, uiElapsed),
+                      (unsigned long) ((8 * bytesPerSecond(uiBytes, uiElapsed)) / 1000),
+                      (unsigned long) (espbaud_get() / 10));
+
+  if (0 != g_tState.stats.uiPongs)
+  {
+    uint16_t uiMin = g_tState.stats.uiMin;
+    uint16_t uiAvg = (uint16_t) (g_tState.stats.uiTotal / g_tState.stats.uiPongs);
+    uint16_t uiMax = g_tState.stats.uiMax;
+    uint16_t auiPercentile[3];
+
+    auiPercentile[0] = histo_percentile(&g_tState.stats.tHisto, 50);
+    auiPercentile[1] = histo_percentile(&g_tState.stats.tHisto, 90);
+    auiPercentile[2] = histo_percentile(&g_tState.stats.tHisto, 99);
+
+    app_printf(stdout, "send min/avg/max = %u.%u/%u.%u/%u.%u [ms]\n",
+                        uiMin / 10, uiMin % 10, uiAvg / 10, uiAvg % 10, uiMax / 10, uiMax % 10);
+    app_printf(stdout, "send p50/p90/p99 = %u.%u/%u.%u/%u.%u [ms]\n",
+                        auiPercentile[0] / 10, auiPercentile[0] % 10,
+                        auiPercentile[1] / 10, auiPercentile[1] % 10,
+                        auiPercentile[2] / 10, auiPercentile[2] % 10);
+  }
+
+  if (0 != esprx_stats()->uiOverruns)
+  {
+    app_printf(stderr, "%u bytes lost on UART\n", esprx_stats()->uiOverruns);
+  }
+
+  /* Wait until break-key is released */
+  while (0 != (g_tState.iKey = in_inkey()))
+  {
+    intrinsic_nop();
+  }
+
+EXIT_THROUGHPUT:
+
+  /* "+++" is only detected after a pause and the ESP8266 is deaf for a
+     while after it */
+  if (bStreaming)
+  {
+    timer_wait_until(timer_now() + TIMER_MS_TO_TICKS(uiPASSTHROUGH_GAP));
+    transmitCommand("+++");
+    timer_wait_until(timer_now() + TIMER_MS_TO_TICKS(uiPASSTHROUGH_GUARD));
+  }
+
+  if (g_tState.bPassthrough && (EOK == transmitCommand(sCMD_AT_CIPMODE "=0\r\n")))
+  {
+    readResponse();
+  }
+
+  closeConnection();
+
+  g_tState.acAddr[0] = '\0';
+
+  return (EOK != iReturn ? iReturn : (0 != uiBytes ? EOK : ETIMEOUT));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* startMonitor()                                                             */
+/*----------------------------------------------------------------------------*/
+int startMonitor(void)
+{
+  int iReturn;
+  uint32_t uiAddr;
+  char_t* pEnd;
+  const char_t* acAddr;
+
+  if (!g_tState.bMonitor)
+  {
+    app_printf(stderr, "driver not installed (.install pingmon.drv)\n");
+    return ENOTSUP;
+  }
+
+  openSession();
+
+  /* The driver pings an IP address; the hostname is resolved once */
+  if (EOK != (iReturn = resolveHost()))
+  {
+    app_printf(stderr, "unknown host \"%s\"\n", g_tState.acHost);
+    return iReturn;
+  }
+
+  acAddr = ('\0' != g_tState.acAddr[0] ? g_tState.acAddr : g_tState.acHost);
+
+  if ((0 == (pEnd = parseAddress(acAddr, &uiAddr))) || ('\0' != *pEnd))
+  {
+    app_printf(stderr, "unable to resolve \"%s\"\n", g_tState.acHost);
+    return EINVAL;
+  }
+
+  /* The command is copied by the driver, so it has to be in main memory */
+  fmt_format(g_tState.esp.acTxBuffer, uiMAX_LEN_CMD, sCMD_AT_PING "=\"%s\"\r\n", acAddr);
+
+  if (EOK != (iReturn = monitor_start(g_tState.esp.acTxBuffer, uiAddr, g_tState.uiInterval)))
+  {
+    app_printf(stderr, "driver rejected the command\n");
+    return iReturn;
+  }
+
+  app_printf(stdout, "monitoring %s in background\n", acAddr);
+  app_printf(stdout, "statistics at %u (CLEAR %u)\n", uiMONITOR_BLOCK, uiMONITOR_BLOCK - 1);
+
+  return EOK;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* showMonitor()                                                              */
+/*----------------------------------------------------------------------------*/
+int showMonitor(void)
+{
+  static const char_t* const acResult[] = { "ok", "timeout", "busy", "error", "no response" };
+  const monitor_block_t* pBlock = monitor_block();
+
+  if (!g_tState.bMonitor)
+  {
+    app_printf(stderr, "driver not installed (.install pingmon.drv)\n");
+    return ENOTSUP;
+  }
+
+  if (('P' != pBlock->acSignature[0]) || ('M' != pBlock->acSignature[1]))
+  {
+    app_printf(stdout, "monitor not started\n");
+    return EOK;
+  }
+
+  /* The driver is paused while this application runs */
+  app_printf(stdout, "monitor %u.%u.%u.%u: %s\n",
+                      pBlock->auiAddr[0], pBlock->auiAddr[1],
+                      pBlock->auiAddr[2], pBlock->auiAddr[3],
+                      (uiMONITOR_STATE_STOPPED == (pBlock->uiState & ~uiMONITOR_STATE_PAUSED) ? "stopped" : "running"));
+  app_printf(stdout, "%u transmitted, %u received, %u%% loss\n",
+                      pBlock->uiSent,
+                      pBlock->uiReceived,
+                      (0 != pBlock->uiSent ? ((uint16_t) ((((uint32_t) (pBlock->uiSent - pBlock->uiReceived)) * 100) / pBlock->uiSent)) : 0));
+
+  if (0 != pBlock->uiReceived)
+  {
+    app_printf(stdout, "rtt min/avg/max = %u/%u/%u [ms]\n",
+                        pBlock->uiMin,
+                        pBlock->uiAvg,
+                        pBlock->uiMax);
+  }
+
+  if (0 != pBlock->uiSent)
+  {
+    app_printf(stdout, "last: %s, %u ms, %u lost in a row\n",
+                        (pBlock->uiResult < (sizeof(acResult) / sizeof(acResult[0])) ? acResult[pBlock->uiResult] : "?"),
+                        pBlock->uiRtt,
+                        pBlock->uiStreak);
+  }
+
+  return EOK;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* uninstallMonitor()                                                         */
+/*----------------------------------------------------------------------------*/
+int uninstallMonitor(void)
+{
+  int iReturn;
+
+  if (!g_tState.bMonitor)
+  {
+    app_printf(stderr, "driver not installed\n");
+    return ENOTSUP;
+  }
+
+  if (EOK != (iReturn = monitor_uninstall()))
+  {
+    app_printf(stderr, "unable to remove driver (.uninstall pingmon.drv)\n");
+    return iReturn;
+  }
+
+  g_tState.bMonitor = false;
+
+  app_printf(stdout, "monitor removed\n");
+
+  return EOK;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* openEsp()                                                                  */
+/*----------------------------------------------------------------------------*/
+void openEsp(void)
+{
+  espready_t tReady;
+
+  if (g_tState.bEspOpen)
+  {
+    return;
+  }
+
+  zxn_setspeed(RTM_28MHZ);
+  esp_open(&g_tState.tEsp);
+  esprx_init();
+
+  g_tState.bEspOpen = true;
+
+  if ('\0' != g_tState.acCapFile[0])
+  {
+    if (EOK != espcap_open(g_tState.acCapFile))
+    {
+      app_printf(stderr, "unable to open \"%s\"\n", g_tState.acCapFile);
+    }
+  }
+
+  /* Last run left the ESP8266 idle: a quick "AT" proves it is still ready */
+  if (espready_load(&tReady) && (0 != (tReady.uiFlags & uiESPREADY_IDLE)))
+  {
+    espbaud_set(tReady.uiBaud);
+
+    g_tState.uiRxTimeout = uiESP_PROBE_TIMEOUT;
+    g_tState.bEspReady   = checkConnection();
+    g_tState.uiRxTimeout = uiESP_RX_TIMEOUT;
+
+    if (g_tState.bEspReady)
+    {
+      return;
+    }
+
+    espbaud_set(uiESPBAUD_DEFAULT);
+  }
+
+  /* Initialize UART/ESP */
+  esp_flush(&g_tState.tEsp);
+  esprx_flush();
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* closeEsp()                                                                 */
+/*----------------------------------------------------------------------------*/
+void closeEsp(void)
+{
+  espready_t tReady;
+
+  if (!g_tState.bEspOpen)
+  {
+    return;
+  }
+
+  if (uiESPBAUD_DEFAULT != espbaud_get())
+  {
+    drainResponse();
+    setBaudrate(uiESPBAUD_DEFAULT);
+  }
+
+  tReady.uiBaud  = espbaud_get();
+  tReady.uiFlags = (g_tState.bPending ? 0 : uiESPREADY_IDLE);
+  espready_store(&tReady);
+
+  if (EOK != espcap_close())
+  {
+    app_printf(stderr, "unable to write \"%s\"\n", g_tState.acCapFile);
+  }
+
+  esprx_exit();
+  esp_close(&g_tState.tEsp);
+
+  g_tState.bEspOpen = false;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* openSession()                                                              */
+/*----------------------------------------------------------------------------*/
+void openSession(void)
+{
+  openEsp();
+
+  /* Faster UART */
+  if (g_tState.uiBaud != espbaud_get())
+  {
+    if (EOK != setBaudrate(g_tState.uiBaud))
+    {
+      app_printf(stderr, "%lu bit/s not usable, using %lu bit/s\n",
+                          (unsigned long) g_tState.uiBaud,
+                          (unsigned long) espbaud_get());
+    }
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* transmitCommand()                                                          */
+/*----------------------------------------------------------------------------*/
+int transmitCommand(const char_t* acCmd)
+{
+  espcap_tx(acCmd);
+
+  return esp_transmit(&g_tState.tEsp, acCmd);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* receiveByte()                                                              */
+/*----------------------------------------------------------------------------*/
+int receiveByte(void)
+{
+  int iByte = esprx_getc();
+
+  if (0 <= iByte)
+  {
+    espcap_rx((uint8_t) iByte);
+  }
+
+  return iByte;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* receivePing()                                                              */
+/*----------------------------------------------------------------------------*/
+uint8_t receivePing(void)
+{
+  int iByte;
+  at_event_t eEvent;
+  bool bBusy  = false;
+  bool bValue = false;
+  uint32_t uiNow      = timer_now();
+  uint32_t uiKey      = uiNow + TIMER_MS_TO_TICKS(uiKEY_POLL);
+  uint32_t uiDeadline = uiNow + TIMER_MS_TO_TICKS(uiESP_RX_TIMEOUT);
+  bool bDeadline      = ((0 != g_tState.uiDeadline) && (uiESP_RX_TIMEOUT > g_tState.uiDeadline));
+
+  /* The deadline of the probe starts with its transmission */
+  if (bDeadline)
+  {
+    uiDeadline = g_tState.stats.auiStamp[STAMP_TX_START] + TIMER_MS_TO_TICKS(g_tState.uiDeadline);
+  }
+
+  at_reset(&g_tState.tParser);
+
+  /* No time of an earlier probe is taken for this one */
+  g_tState.stats.uiTime = 0;
+  g_tState.stats.auiStamp[STAMP_RX_FIRST] = 0;
+
+  for ( ; ; )
+  {
+    if (0 > (iByte = receiveByte()))
+    {
+      uiNow = timer_now();
+
+      if (TIMER_BEFORE(uiDeadline, uiNow))
+      {
+        /* Lost: the ESP8266 reports the timeout later */
+        g_tState.bPending = bDeadline;
+        return (bDeadline ? uiRECLOG_RESULT_TIMEOUT : uiRECLOG_RESULT_COMM);
+      }
+
+      if (TIMER_BEFORE(uiKey, uiNow))
+      {
+        if (userBreak())
+        {
+          g_tState.bPending = true;
+          return uiPING_RESULT_BREAK;
+        }
+
+        uiKey = uiNow + TIMER_MS_TO_TICKS(uiKEY_POLL);
+      }
+
+      continue;
+    }
+
+    if (0 == g_tState.stats.auiStamp[STAMP_RX_FIRST])
+    {
+      g_tState.stats.auiStamp[STAMP_RX_FIRST] = timer_now();
+    }
+
+    eEvent = at_parse(&g_tState.tParser, (uint8_t) iByte);
+
+    if (AT_EVENT_NONE == eEvent)
+    {
+      continue;
+    }
+
+    g_tState.stats.auiStamp[STAMP_RX_DONE] = timer_now();
+
+    if (AT_EVENT_VALUE == eEvent)
+    {
+      g_tState.stats.uiTime = g_tState.tParser.uiValue;
+      bValue = true;
+    }
+    else if (AT_EVENT_CONNECT == eEvent)
+    {
+      /* "-p": the ESP8266 reports no time, the handshake is measured by the
+         CTC from the end of the command (rounded to ms) */
+      g_tState.stats.uiTime = (uint16_t) TIMER_TICKS_TO_MS(g_tState.stats.auiStamp[STAMP_RX_DONE] -
+                                                           g_tState.stats.auiStamp[STAMP_TX_DONE] +
+                                                           (uiTIMER_TICKS_PER_MS / 2));
+      bValue = true;
+    }
+    else if (AT_EVENT_BUSY == eEvent)
+    {
+      /* Request is dropped; wait for the end of the previous command */
+      bBusy = true;
+    }
+    else if (bBusy)
+    {
+      return uiRECLOG_RESULT_BUSY;
+    }
+    else if (AT_EVENT_OK == eEvent)
+    {
+      /* "OK" without time: not the response to this probe */
+      return (bValue ? uiRECLOG_RESULT_OK : uiRECLOG_RESULT_COMM);
+    }
+    else if (AT_EVENT_ERROR == eEvent)
+    {
+      return uiRECLOG_RESULT_ERROR;
+    }
+    else /* AT_EVENT_FAIL */
+    {
+      return uiRECLOG_RESULT_TIMEOUT;
+    }
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* drainResponse()                                                            */
+/*----------------------------------------------------------------------------*/
+bool drainResponse(void)
+{
+  int iByte;
+  at_event_t eEvent;
+  uint32_t uiNow      = timer_now();
+  uint32_t uiKey      = uiNow + TIMER_MS_TO_TICKS(uiKEY_POLL);
+  uint32_t uiDeadline = uiNow + TIMER_MS_TO_TICKS(uiESP_RX_TIMEOUT);
+
+  /* The parser continues where "receivePing" stopped */
+  while (g_tState.bPending)
+  {
+    if (0 > (iByte = receiveByte()))
+    {
+      uiNow = timer_now();
+
+      if (TIMER_BEFORE(uiDeadline, uiNow))
+      {
+        g_tState.bPending = false;
+      }
+      else if (TIMER_BEFORE(uiKey, uiNow))
+      {
+        if (userBreak())
+        {
+          return false;
+        }
+
+        uiKey = uiNow + TIMER_MS_TO_TICKS(uiKEY_POLL);
+      }
+
+      continue;
+    }
+
+    eEvent = at_parse(&g_tState.tParser, (uint8_t) iByte);
+
+    if ((AT_EVENT_OK == eEvent) || (AT_EVENT_ERROR == eEvent) || (AT_EVENT_FAIL == eEvent))
+    {
+      g_tState.bPending = false;
+    }
+  }
+
+  return true;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* closeConnection()                                                          */
+/*----------------------------------------------------------------------------*/
+void closeConnection(void)
+{
+  if (g_tState.bPending && !drainResponse())
+  {
+    g_tState.bPending = false;
+  }
+
+  /* "CLOSED", "OK"; "ERROR" if the connect failed */
+  if (EOK == transmitCommand(sCMD_AT_CIPCLOSE "\r\n"))
+  {
+    readResponse();
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* waitPrompt()                                                               */
+/*----------------------------------------------------------------------------*/
+bool waitPrompt(void)
+{
+  int iByte;
+  at_event_t eEvent;
+  uint32_t uiDeadline = timer_now() + TIMER_MS_TO_TICKS(g_tState.uiRxTimeout);
+
+  at_reset(&g_tState.tParser);
+
+  for ( ; ; )
+  {
+    if (0 > (iByte = receiveByte()))
+    {
+      if (TIMER_BEFORE(uiDeadline, timer_now()))
+      {
+        return false;
+      }
+
+      continue;
+    }
+
+    if ('>' == iByte)
+    {
+      return true;
+    }
+
+    eEvent = at_parse(&g_tState.tParser, (uint8_t) iByte);
+
+    if ((AT_EVENT_ERROR == eEvent) || (AT_EVENT_FAIL == eEvent))
+    {
+      return false;
+    }
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* userBreak()                                                                */
+/*----------------------------------------------------------------------------*/
+bool userBreak(void)
+{
+  if (0 != (g_tState.iKey = in_inkey()))
+  {
+    switch (g_tState.iKey)
+    {
+      case ' ':
+      case 'c':
+      case 'C':
+      case 'q':
+      case 'Q':
+        return true;
+    }
+  }
+
+  if (in_key_pressed(IN_KEY_SCANCODE_SPACE | 0x8000)) /* BREAK = CAPS + SPACE */
+  {
+    return true;
+  }
+
+  return false;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* waitUntil()                                                                */
+/*----------------------------------------------------------------------------*/
+bool waitUntil(uint32_t uiDeadline)
+{
+  uint32_t uiNext;
+
+  for ( ; ; )
+  {
+    if (userBreak())
+    {
+      return true;
+    }
+
+    uiNext = timer_now() + TIMER_MS_TO_TICKS(uiKEY_POLL);
+
+    if (!TIMER_BEFORE(uiNext, uiDeadline))
+    {
+      timer_wait_until(uiDeadline);
+      return false;
+    }
+
+    timer_wait_until(uiNext);
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* parseAddress()                                                             */
+/*----------------------------------------------------------------------------*/
+char_t* parseAddress(const char_t* acAddr, uint32_t* puiAddr)
+{
+  char_t* pEnd = (char_t*) acAddr;
+  uint32_t uiValue;
+  uint8_t i;
+
+  *puiAddr = 0;
+
+  for (i = 0; i < 4; ++i)
+  {
+    if (('0' > *pEnd) || ('9' < *pEnd) || (255 < (uiValue = strtoul(pEnd, &pEnd, 10))))
+    {
+      return 0;
+    }
+
+    *puiAddr = (*puiAddr << 8) | uiValue;
+
+    if ((i < 3) && ('.' != *pEnd++))
+    {
+      return 0;
+    }
+  }
+
+  return pEnd;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* parseRange()                                                               */
+/*----------------------------------------------------------------------------*/
+bool parseRange(const char_t* acRange, uint32_t* puiFirst, uint32_t* puiLast)
+{
+  char_t* pEnd;
+  uint32_t uiAddr;
+  uint32_t uiValue;
+
+  if (0 == (pEnd = parseAddress(acRange, &uiAddr)))
+  {
+    return false;
+  }
+
+  if ('/' == *pEnd) /* a.b.c.d/n */
+  {
+    if (('0' > pEnd[1]) || ('9' < pEnd[1]) ||
+        (32 < (uiValue = strtoul(pEnd + 1, &pEnd, 10))) || (16 > uiValue) || ('\0' != *pEnd))
+    {
+      return false;
+    }
+
+    uiValue   = (32 > uiValue ? (0xFFFFFFFFUL >> uiValue) : 0);
+    *puiFirst = uiAddr & ~uiValue;
+    *puiLast  = uiAddr | uiValue;
+
+    if (1 < uiValue)
+    {
+      ++(*puiFirst);
+      --(*puiLast);
+    }
+
+    return true;
+  }
+
+  if ('-' == *pEnd) /* a.b.c.d-e */
+  {
+    if (('0' > pEnd[1]) || ('9' < pEnd[1]) ||
+        (255 < (uiValue = strtoul(pEnd + 1, &pEnd, 10))) || (uiValue < (uiAddr & 0xFF)) || ('\0' != *pEnd))
+    {
+      return false;
+    }
+
+    *puiFirst = uiAddr;
+    *puiLast  = (uiAddr & 0xFFFFFF00UL) | uiValue;
+
+    return true;
+  }
+
+  return false;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* looksLikeRange()                                                           */
+/*----------------------------------------------------------------------------*/
+bool looksLikeRange(const char_t* acArg)
+{
+  uint8_t i;
+
+  for (i = 0; i < 3; ++i)
+  {
+    if (('0' > *acArg) || ('9' < *acArg))
+    {
+      return false;
+    }
+
+    while (('0' <= *acArg) && ('9' >= *acArg))
+    {
+      ++acArg;
+    }
+
+    if ('.' != *acArg++)
+    {
+      return false;
+    }
+  }
+
+  return (0 != strchr(acArg, '-'));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* setBaudrate()                                                              */
+/*----------------------------------------------------------------------------*/
+int setBaudrate(uint32_t uiBaud)
+{
+  fmt_format(g_tState.esp.acTxBuffer, uiMAX_LEN_CMD, sCMD_AT_UART_CUR "=%lu,8,1,0,0\r\n", (unsigned long) uiBaud);
+
+  /* The ESP8266 confirms with the old baudrate and switches afterwards */
+  if ((EOK != transmitCommand(g_tState.esp.acTxBuffer)) || (AT_EVENT_OK != readResponse()))
+  {
+    return ENOTSUP;
+  }
+
+  zxn_sleep_ms(uiESP_BAUD_SETTLE);
+  espbaud_set(uiBaud);
+  esprx_flush();
+
+  /* "OK" to "AT" takes a few ms: a failed switch must not stall the start */
+  g_tState.uiRxTimeout = uiESP_PROBE_TIMEOUT;
+
+  if (checkConnection())
+  {
+    g_tState.uiRxTimeout = uiESP_RX_TIMEOUT;
+    return EOK;
+  }
+
+  /* The ESP8266 may understand us even if we can't understand it */
+  if (uiESPBAUD_DEFAULT != uiBaud)
+  {
+    fmt_format(g_tState.esp.acTxBuffer, uiMAX_LEN_CMD, sCMD_AT_UART_CUR "=%lu,8,1,0,0\r\n", (unsigned long) uiESPBAUD_DEFAULT);
+    transmitCommand(g_tState.esp.acTxBuffer);
+    zxn_sleep_ms(uiESP_BAUD_SETTLE);
+  }
+
+  espbaud_set(uiESPBAUD_DEFAULT);
+  esprx_flush();
+  checkConnection();
+
+  g_tState.uiRxTimeout = uiESP_RX_TIMEOUT;
+
+  return ENOTSUP;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* checkConnection()                                                          */
+/*----------------------------------------------------------------------------*/
+bool checkConnection(void)
+{
+  return ((EOK == transmitCommand(sCMD_AT "\r\n")) && (AT_EVENT_OK == readResponse()));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* resolveHost()                                                              */
+/*----------------------------------------------------------------------------*/
+int resolveHost(void)
+{
+  uint32_t uiStart = timer_now();
+  at_event_t eEvent;
+  bool bUnknown = false;
+  char_t* acValue;
+
+  g_tState.acAddr[0] = '\0';
+
+  /* IP address ? */
+  if (strlen(g_tState.acHost) == strspn(g_tState.acHost, "0123456789."))
+  {
+    return EOK;
+  }
+
+  /* Cache file ? */
+  if (dnscache_lookup(g_tState.acHost, g_tState.acAddr))
+  {
+    g_tState.stats.uiResolve = (uint16_t) TIMER_TICKS_TO_MS(timer_now() - uiStart);
+    g_tState.stats.bCached   = true;
+    return EOK;
+  }
+
+  fmt_format(g_tState.esp.acTxBuffer, uiMAX_LEN_CMD, sCMD_AT_CIPDOMAIN "=\"%s\"\r\n", g_tState.acHost);
+
+  if (EOK != transmitCommand(g_tState.esp.acTxBuffer))
+  {
+    return EOK;
+  }
+
+  /* "+CIPDOMAIN:1.2.3.4" (newer firmwares quote the address) */
+  while (AT_EVENT_NONE == (eEvent = readLine()))
+  {
+    if (0 == strncmp(g_tState.esp.acRxBuffer, "+CIPDOMAIN:", 11))
+    {
+      acValue = g_tState.esp.acRxBuffer + 11 + ('"' == g_tState.esp.acRxBuffer[11] ? 1 : 0);
+      acValue[strcspn(acValue, "\"\r\n")] = '\0';
+      fmt_format(g_tState.acAddr, sizeof(g_tState.acAddr), "%s", acValue);
+    }
+    else if (0 == strncmp(g_tState.esp.acRxBuffer, "DNS Fail", 8))
+    {
+      bUnknown = true;
+    }
+  }
+
+  g_tState.stats.uiResolve = (uint16_t) TIMER_TICKS_TO_MS(timer_now() - uiStart);
+
+  if (bUnknown)
+  {
+    return ERANGE;
+  }
+
+  if ((AT_EVENT_OK != eEvent) || ('\0' == g_tState.acAddr[0]))
+  {
+    /* Firmware without "AT+CIPDOMAIN": the ESP8266 resolves on each ping */
+    g_tState.acAddr[0] = '\0';
+    return EOK;
+  }
+
+  dnscache_store(g_tState.acHost, g_tState.acAddr);
+
+  return EOK;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* readLine()                                                                 */
+/*----------------------------------------------------------------------------*/
+at_event_t readLine(void)
+{
+  at_event_t eEvent;
+  uint32_t uiDeadline = timer_now() + TIMER_MS_TO_TICKS(g_tState.uiRxTimeout);
+  uint8_t uiLen = 0;
+  int iByte;
+
+  at_reset(&g_tState.tParser);
+
+  for ( ; ; )
+  {
+    if (0 > (iByte = receiveByte()))
+    {
+      if (TIMER_BEFORE(uiDeadline, timer_now()))
+      {
+        g_tState.esp.acRxBuffer[0] = '\0';
+        return AT_EVENT_FAIL;
+      }
+
+      continue;
+    }
+
+    if (uiLen < (uiMAX_LEN_CMD - 1))
+    {
+      g_tState.esp.acRxBuffer[uiLen++] = (char_t) iByte;
+    }
+
+    eEvent = at_parse(&g_tState.tParser, (uint8_t) iByte);
+
+    if ('\n' == iByte)
+    {
+      g_tState.esp.acRxBuffer[uiLen] = '\0';
+
+      if ((AT_EVENT_NONE != eEvent) && (AT_EVENT_VALUE != eEvent) && (AT_EVENT_CONNECT != eEvent))
+      {
+        return eEvent;
+      }
+
+      if (('\r' != g_tState.esp.acRxBuffer[0]) && ('\n' != g_tState.esp.acRxBuffer[0]))
+      {
+        return AT_EVENT_NONE;
+      }
+
+      uiLen = 0;
+    }
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* readResponse()                                                             */
+/*----------------------------------------------------------------------------*/
+at_event_t readResponse(void)
+{
+  at_event_t eEvent;
+
+  while (AT_EVENT_NONE == (eEvent = readLine()))
+  {
+    intrinsic_nop();
+  }
+
+  return eEvent;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* bytesPerSecond()                                                           */
+/*----------------------------------------------------------------------------*/
+uint32_t bytesPerSecond(uint32_t uiBytes, uint32_t uiMs)
+{
+  if (0 == uiMs)
+  {
+    return 0;
+  }
+
+  /* The remainder is less than uiMs, so "* 1000" fits for up to 71 minutes */
+  return ((uiBytes / uiMs) * 1000) + (((uiBytes % uiMs) * 1000) / uiMs);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* resetStatistics()                                                          */
+/*----------------------------------------------------------------------------*/
+void resetStatistics(void)
+{
+  uint8_t i;
+
+  g_tState.stats.uiResolve = 0;
+  g_tState.stats.uiStartup = 0;
+  g_tState.stats.bCached   = false;
+  g_tState.stats.uiTotal   = 0;
+  g_tState.stats.uiTime    = 0;
+  g_tState.stats.uiMin     = UINT16_MAX;
+  g_tState.stats.uiMax     = 0;
+  g_tState.stats.uiPings   = 0;
+  g_tState.stats.uiPongs   = 0;
+  g_tState.stats.uiLate    = 0;
+  g_tState.stats.uiSkipped = 0;
+  g_tState.stats.uiSlow    = 0;
+
+  histo_reset(&g_tState.stats.tHisto);
+
+  for (i = 0; i < PHASE_COUNT; ++i)
+  {
+    g_tState.stats.atPhase[i].uiTotal = 0;
+    g_tState.stats.atPhase[i].uiMin   = UINT16_MAX;
+    g_tState.stats.atPhase[i].uiMax   = 0;
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* updateStatistics()                                                         */
+/*----------------------------------------------------------------------------*/
+void updateStatistics(void)
+{
+  ++g_tState.stats.uiPongs;
+
+  g_tState.stats.uiTotal += g_tState.stats.uiTime;
+
+  if (g_tState.stats.uiTime < g_tState.stats.uiMin)
+  {
+    g_tState.stats.uiMin = g_tState.stats.uiTime;
+  }
+
+  if (g_tState.stats.uiTime > g_tState.stats.uiMax)
+  {
+    g_tState.stats.uiMax = g_tState.stats.uiTime;
+  }
+
+  histo_add(&g_tState.stats.tHisto, g_tState.stats.uiTime);
+
+  if ((0 != g_tState.uiMaxP95) && (g_tState.stats.uiTime > g_tState.uiMaxP95))
+  {
+    ++g_tState.stats.uiSlow;
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* updatePhases()                                                             */
+/*----------------------------------------------------------------------------*/
+void updatePhases(void)
+{
+  uint32_t* pStamp = g_tState.stats.auiStamp;
+  uint16_t auiPhase[PHASE_COUNT];
+  uint8_t i;
+
+  auiPhase[PHASE_UART_TX] = (uint16_t) TIMER_TICKS_TO_100US(pStamp[STAMP_TX_DONE]    - pStamp[STAMP_TX_START]);
+  auiPhase[PHASE_ESP]     = (uint16_t) TIMER_TICKS_TO_100US(pStamp[STAMP_RX_FIRST]   - pStamp[STAMP_TX_DONE]);
+  auiPhase[PHASE_UART_RX] = (uint16_t) TIMER_TICKS_TO_100US(pStamp[STAMP_RX_DONE]    - pStamp[STAMP_RX_FIRST]);
+  auiPhase[PHASE_LOCAL]   = (uint16_t) TIMER_TICKS_TO_100US(pStamp[STAMP_LOCAL_DONE] - pStamp[STAMP_RX_DONE]);
+
+  /* The network part of the wait time is the RTT reported by the ESP8266 */
+  auiPhase[PHASE_NETWORK] = g_tState.stats.uiTime * uiTIMER_TICKS_PER_MS;
+
+  if (auiPhase[PHASE_NETWORK] > auiPhase[PHASE_ESP])
+  {
+    auiPhase[PHASE_NETWORK] = auiPhase[PHASE_ESP];
+  }
+
+  auiPhase[PHASE_ESP] -= auiPhase[PHASE_NETWORK];
+
+  for (i = 0; i < PHASE_COUNT; ++i)
+  {
+    phasestats_t* pPhase = &g_tState.stats.atPhase[i];
+
+    pPhase->uiTotal += auiPhase[i];
+
+    if (auiPhase[i] < pPhase->uiMin)
+    {
+      pPhase->uiMin = auiPhase[i];
+    }
+
+    if (auiPhase[i] > pPhase->uiMax)
+    {
+      pPhase->uiMax = auiPhase[i];
+    }
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* updateDashboard()                                                          */
+/*----------------------------------------------------------------------------*/
+void updateDashboard(bool bOk)
+{
+  uint16_t uiPings = g_tState.stats.uiPings;
+  uint16_t uiPongs = g_tState.stats.uiPongs;
+
+  dash_column(uiPings - 1, bOk, g_tState.stats.uiTime);
+
+  dash_counter(DASH_MIN, (UINT16_MAX != g_tState.stats.uiMin ? g_tState.stats.uiMin : 0));
+  dash_counter(DASH_AVG, (0 != uiPongs ? ((uint16_t) (g_tState.stats.uiTotal / uiPongs)) : 0));
+  dash_counter(DASH_MAX, g_tState.stats.uiMax);
+  dash_counter(DASH_LOSS, (uint16_t) ((((uint32_t) (uiPings - uiPongs)) * 100) / uiPings));
+  dash_counter(DASH_PINGS, uiPings);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* nextSlot()                                                                 */
+/*----------------------------------------------------------------------------*/
+uint32_t nextSlot(uint32_t uiSlot)
+{
+  uint32_t uiPeriod = TIMER_MS_TO_TICKS(g_tState.uiInterval);
+  uint32_t uiNow    = timer_now();
+
+  uiSlot += uiPeriod;
+
+  if (TIMER_BEFORE(uiSlot, uiNow))
+  {
+    uint32_t uiMissed = (uiNow - uiSlot) / uiPeriod;
+
+    ++g_tState.stats.uiLate;
+    g_tState.stats.uiSkipped += (uint16_t) uiMissed;
+
+    uiSlot += uiMissed * uiPeriod;
+  }
+
+  return uiSlot;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* exportStatistics()                                                         */
+/*----------------------------------------------------------------------------*/
+void exportStatistics(void)
+{
+  statexp_t tBlock;
+  uint16_t uiPings = g_tState.stats.uiPings;
+  uint16_t uiPongs = g_tState.stats.uiPongs;
+
+  if (!g_tState.bExport && (uiEXPORT_NO_VAR == g_tState.uiExportVar))
+  {
+    return;
+  }
+
+  memset(&tBlock, 0, sizeof(tBlock));
+
+  tBlock.acSignature[0] = 'P';
+  tBlock.acSignature[1] = 'S';
+  tBlock.uiResult   = (uint8_t) g_tState.iExitCode;
+  tBlock.uiFlags    = (((ACTION_ECHO == g_tState.eAction) || (ACTION_THROUGHPUT == g_tState.eAction)) ?
+                       uiSTATEXP_FLAG_TENTHS : 0);
+  tBlock.uiSent     = uiPings;
+  tBlock.uiReceived = uiPongs;
+  tBlock.uiLoss     = (0 != uiPings ? (uint16_t) ((100UL * (uiPings - uiPongs)) / uiPings) : 0);
+
+  if (0 != uiPongs)
+  {
+    tBlock.uiFlags |= uiSTATEXP_FLAG_PERCENTILES;
+    tBlock.uiMin  = g_tState.stats.uiMin;
+    tBlock.uiAvg  = (uint16_t) (g_tState.stats.uiTotal / uiPongs);
+    tBlock.uiMax  = g_tState.stats.uiMax;
+    tBlock.uiP50  = histo_percentile(&g_tState.stats.tHisto, 50);
+    tBlock.uiP90  = histo_percentile(&g_tState.stats.tHisto, 90);
+    tBlock.uiP99  = histo_percentile(&g_tState.stats.tHisto, 99);
+    tBlock.uiMdev = histo_mdev(&g_tState.stats.tHisto);
+  }
+
+  if (g_tState.bExport)
+  {
+    statexp_write(&tBlock, g_tState.uiExportBank, g_tState.uiExportAddr);
+  }
+
+  if (uiEXPORT_NO_VAR != g_tState.uiExportVar)
+  {
+    statexp_basic(&tBlock, g_tState.uiExportVar);
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* checkSlo()                                                                 */
+/*----------------------------------------------------------------------------*/
+int checkSlo(bool bFinal)
+{
+  uint16_t uiLost = g_tState.stats.uiPings - g_tState.stats.uiPongs;
+  uint32_t uiPings;
+  uint32_t uiPongs;
+
+  if (bFinal)
+  {
+    uiPings = g_tState.stats.uiPings;
+    uiPongs = g_tState.stats.uiPongs;
+  }
+  else
+  {
+    /* Worst case for the check: all remaining pings answered in 0 ms */
+    if ((0 == g_tState.uiCount) || (g_tState.stats.uiPings >= g_tState.uiCount))
+    {
+      return EOK;
+    }
+
+    uiPings = g_tState.uiCount;
+    uiPongs = g_tState.stats.uiPongs + (g_tState.uiCount - g_tState.stats.uiPings);
+  }
+
+  if ((uiSLO_OFF != g_tState.uiMaxLoss) && (0 != uiPings) &&
+      ((100UL * uiLost) > ((uint32_t) g_tState.uiMaxLoss * uiPings)))
+  {
+    return ESLO_LOSS;
+  }
+
+  if ((0 != g_tState.uiMaxAvg) && (0 != uiPongs) &&
+      (g_tState.stats.uiTotal > ((uint32_t) g_tState.uiMaxAvg * uiPongs)))
+  {
+    return ESLO_AVG;
+  }
+
+  /* Exact count instead of the histogram: more than 5% above the threshold */
+  if ((0 != g_tState.uiMaxP95) && (0 != uiPongs) &&
+      ((100UL * g_tState.stats.uiSlow) > ((100 - uiSLO_PERCENTILE) * uiPongs)))
+  {
+    return ESLO_P95;
+  }
+
+  return EOK;
+}
+
+
 /*----------------------------------------------------------------------------*/
 /*                                                                            */
 /*----------------------------------------------------------------------------*/
@@ -0,0 +1,174 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: monitor.c                                                          |
+| project:  ZX Spectrum Next - PING                                            |
+| author:   Stefan Zell                                                        |
+| date:     16/10/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Resident background monitor                                                  |
+|                                                                              |
+| Calls of the NextZXOS driver "pingmon.drv" (see "monitor.h").                |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 16/10/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <arch/zxn/esxdos.h>
+
+#include "libzxn.h"
+#include "monitor.h"
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+Driver API of NextZXOS (driver id 0): remove the driver with the id in E
+*/
+#define uiMONITOR_SYSTEM           (0x00)
+#define uiMONITOR_SYSTEM_UNINSTALL (0x02)
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+/*!
+Call the API of a driver
+@param uiDriver Id of the driver
+@param uiCall Call id (B)
+@param uiDe Parameter (DE)
+@param uiHl Parameter (HL)
+@return EOK = the driver is installed and accepted the call
+*/
+static int monitor_call(uint8_t uiDriver, uint8_t uiCall, uint16_t uiDe, uint16_t uiHl);
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/* monitor_pause()                                                            */
+/*----------------------------------------------------------------------------*/
+bool monitor_pause(bool bPause)
+{
+  return (EOK == monitor_call(uiMONITOR_DRIVER_ID, uiMONITOR_CALL_PAUSE, (bPause ? 1 : 0), 0));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* monitor_start()                                                            */
+/*----------------------------------------------------------------------------*/
+int monitor_start(const char* acCmd, uint32_t uiAddr, uint16_t uiInterval)
+{
+  int iReturn;
+  monitor_block_t* pBlock = (monitor_block_t*) uiMONITOR_BLOCK;
+  uint16_t uiFrames = uiInterval / uiMONITOR_FRAME_MS;
+
+  if (EOK == (iReturn = monitor_call(uiMONITOR_DRIVER_ID, uiMONITOR_CALL_INTERVAL, uiFrames, 0)))
+  {
+    if (EOK == (iReturn = monitor_call(uiMONITOR_DRIVER_ID, uiMONITOR_CALL_START, 0, (uint16_t) acCmd)))
+    {
+      pBlock->auiAddr[0] = (uint8_t) (uiAddr >> 24);
+      pBlock->auiAddr[1] = (uint8_t) (uiAddr >> 16);
+      pBlock->auiAddr[2] = (uint8_t) (uiAddr >>  8);
+      pBlock->auiAddr[3] = (uint8_t) (uiAddr);
+    }
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* monitor_uninstall()                                                        */
+/*----------------------------------------------------------------------------*/
+int monitor_uninstall(void)
+{
+  int iReturn;
+
+  if (EOK == (iReturn = monitor_call(uiMONITOR_DRIVER_ID, uiMONITOR_CALL_STOP, 0, 0)))
+  {
+    iReturn = monitor_call(uiMONITOR_SYSTEM, uiMONITOR_SYSTEM_UNINSTALL, uiMONITOR_DRIVER_ID, 0);
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* monitor_block()                                                            */
+/*----------------------------------------------------------------------------*/
+const monitor_block_t* monitor_block(void)
+{
+  return (const monitor_block_t*) uiMONITOR_BLOCK;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* monitor_call()                                                             */
+/*----------------------------------------------------------------------------*/
+static int monitor_call(uint8_t uiDriver, uint8_t uiCall, uint16_t uiDe, uint16_t uiHl)
+{
+  struct esx_drvapi tApi;
+
+  tApi.call = (((uint16_t) uiCall) << 8) | uiDriver;
+  tApi.de   = uiDe;
+  tApi.hl   = uiHl;
+
+  return (0 == esx_m_drvapi(&tApi) ? EOK : ENOTSUP);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
@@ -0,0 +1,238 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: reclog.c                                                           |
+| project:  ZX Spectrum Next - PING                                            |
+| author:   Stefan Zell                                                        |
+| date:     16/10/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Binary log of the results of all pings ("-o file")                           |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 16/10/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <arch/zxn/esxdos.h>
+
+#include "libzxn.h"
+#include "timer.h"
+#include "bankmem.h"
+#include "reclog.h"
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+Number of records in the write buffer
+*/
+#define uiRECLOG_RECORDS (uiRECLOG_BUFFER_SIZE / sizeof(reclog_record_t))
+
+/*!
+Handle of esxDOS if no file is open
+*/
+#define uiRECLOG_NO_HANDLE (0xFF)
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+/*!
+State of the log file; the records are collected in a sector sized buffer
+(allocated in the memory arena by the first "reclog_open"), so the SD card is
+written only once per 64 pings
+*/
+static struct
+{
+  reclog_record_t* atRecord;
+  uint8_t  uiCount;
+  uint8_t  uiHandle;
+  uint32_t uiStart;
+} g_tLog = { .uiHandle = uiRECLOG_NO_HANDLE };
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+/*!
+Write all records of the buffer to the file
+@return EOK or errorcode of esxDOS
+*/
+static int reclog_flush(void);
+
+/*!
+Store a record in the buffer; the buffer is written if it is full
+@return EOK or errorcode of esxDOS
+*/
+static int reclog_put(uint32_t uiTime, uint16_t uiRtt, uint8_t uiSeq, uint8_t uiResult);
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/* reclog_open()                                                              */
+/*----------------------------------------------------------------------------*/
+int reclog_open(const char* acFile, uint16_t uiInterval, bool bFixedRate)
+{
+  struct esx_stat tStat;
+
+  reclog_close();
+
+  if ((0 == g_tLog.atRecord) && (0 == (g_tLog.atRecord = bankmem_alloc(uiRECLOG_BUFFER_SIZE))))
+  {
+    return ENOMEM;
+  }
+
+  if (uiRECLOG_NO_HANDLE == (g_tLog.uiHandle = esx_f_open((char*) acFile, ESX_MODE_WRITE | ESX_MODE_OPEN_CREAT)))
+  {
+    return errno;
+  }
+
+  /* Append to the end of the file */
+  if ((0 != esx_f_fstat(g_tLog.uiHandle, &tStat)) ||
+      (tStat.size != esx_f_seek(g_tLog.uiHandle, tStat.size, ESX_SEEK_SET)))
+  {
+    int iReturn = errno;
+
+    esx_f_close(g_tLog.uiHandle);
+    g_tLog.uiHandle = uiRECLOG_NO_HANDLE;
+
+    return iReturn;
+  }
+
+  g_tLog.uiCount = 0;
+  g_tLog.uiStart = timer_now();
+
+  return reclog_put(0, uiInterval, (bFixedRate ? 0x01 : 0x00), uiRECLOG_RESULT_START);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* reclog_add()                                                               */
+/*----------------------------------------------------------------------------*/
+int reclog_add(uint16_t uiSeq, uint16_t uiRtt, uint8_t uiResult)
+{
+  if (uiRECLOG_NO_HANDLE == g_tLog.uiHandle)
+  {
+    return EOK;
+  }
+
+  return reclog_put(TIMER_TICKS_TO_100US(timer_now() - g_tLog.uiStart), uiRtt, (uint8_t) uiSeq, uiResult);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* reclog_close()                                                             */
+/*----------------------------------------------------------------------------*/
+int reclog_close(void)
+{
+  int iReturn = EOK;
+
+  if (uiRECLOG_NO_HANDLE != g_tLog.uiHandle)
+  {
+    iReturn = reclog_flush();
+
+    if ((0 != esx_f_close(g_tLog.uiHandle)) && (EOK == iReturn))
+    {
+      iReturn = errno;
+    }
+
+    g_tLog.uiHandle = uiRECLOG_NO_HANDLE;
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* reclog_flush()                                                             */
+/*----------------------------------------------------------------------------*/
+static int reclog_flush(void)
+{
+  uint16_t uiSize = g_tLog.uiCount * sizeof(reclog_record_t);
+
+  g_tLog.uiCount = 0;
+
+  if (0 != uiSize)
+  {
+    if (uiSize != esx_f_write(g_tLog.uiHandle, g_tLog.atRecord, uiSize))
+    {
+      return errno;
+    }
+  }
+
+  return EOK;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* reclog_put()                                                               */
+/*----------------------------------------------------------------------------*/
+static int reclog_put(uint32_t uiTime, uint16_t uiRtt, uint8_t uiSeq, uint8_t uiResult)
+{
+  reclog_record_t* pRecord = &g_tLog.atRecord[g_tLog.uiCount];
+
+  /* The Z80 is little endian like the file format */
+  pRecord->uiTime   = uiTime;
+  pRecord->uiRtt    = uiRtt;
+  pRecord->uiSeq    = uiSeq;
+  pRecord->uiResult = uiResult;
+
+  if (uiRECLOG_RECORDS <= ++g_tLog.uiCount)
+  {
+    return reclog_flush();
+  }
+
+  return EOK;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
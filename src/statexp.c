@@ -0,0 +1,216 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: statexp.c                                                          |
+| project:  ZX Spectrum Next - PING                                            |
+| author:   Stefan Zell                                                        |
+| date:     16/10/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Export of the statistics to memory and integer variables of NextBASIC        |
+| ("-x", "-X")                                                                 |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 16/10/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <arch/zxn.h>
+
+#include "libzxn.h"
+#include "bankmem.h"
+#include "statexp.h"
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+Next register of the MMU slot that is used to write to a bank (the slot of
+the arena, which is released before)
+*/
+#define uiSTATEXP_MMU_REG (0x50 + uiBANKMEM_SLOT)
+
+/*!
+Address of the MMU slot
+*/
+#define pSTATEXP_BASE ((uint8_t*) (uiBANKMEM_SLOT * uiBANKMEM_PAGE_SIZE))
+
+/*!
+Call id of "IDE_INTEGER_VAR" (NextZXOS API, called by "M_P3DOS")
+*/
+#define uiSTATEXP_IDE_INTEGER_VAR (0x01C9)
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+/*!
+Set an integer variable of NextBASIC
+@param uiVar Variable (0 = %a, ..., 25 = %z)
+@param uiValue Value
+@return "true" if the variable is set
+*/
+static bool statexp_set(uint16_t uiVar, uint16_t uiValue) __naked;
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/* statexp_write()                                                            */
+/*----------------------------------------------------------------------------*/
+void statexp_write(const statexp_t* pBlock, uint8_t uiBank, uint16_t uiAddr)
+{
+  const uint8_t* pSrc = (const uint8_t*) pBlock;
+  uint8_t uiSaved;
+  uint8_t uiPage = 0xFF;
+  uint8_t i;
+
+  if (uiSTATEXP_NO_BANK == uiBank)
+  {
+    memcpy((void*) uiAddr, pBlock, sizeof(*pBlock));
+    return;
+  }
+
+  /* The block may cross the 8K pages of the bank */
+  uiSaved = ZXN_READ_REG(uiSTATEXP_MMU_REG);
+
+  for (i = 0; i < sizeof(*pBlock); ++i, ++uiAddr)
+  {
+    if (uiPage != ((uiBank << 1) + (uiAddr >> 13)))
+    {
+      uiPage = (uiBank << 1) + (uiAddr >> 13);
+      ZXN_WRITE_REG(uiSTATEXP_MMU_REG, uiPage);
+    }
+
+    pSTATEXP_BASE[uiAddr & (uiBANKMEM_PAGE_SIZE - 1)] = pSrc[i];
+  }
+
+  ZXN_WRITE_REG(uiSTATEXP_MMU_REG, uiSaved);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* statexp_basic()                                                            */
+/*----------------------------------------------------------------------------*/
+bool statexp_basic(const statexp_t* pBlock, uint8_t uiVar)
+{
+  uint16_t auiValue[uiSTATEXP_VARS];
+  uint8_t i;
+
+  auiValue[0] = pBlock->uiResult;
+  auiValue[1] = pBlock->uiSent;
+  auiValue[2] = pBlock->uiReceived;
+  auiValue[3] = pBlock->uiLoss;
+  auiValue[4] = pBlock->uiMin;
+  auiValue[5] = pBlock->uiAvg;
+  auiValue[6] = pBlock->uiMax;
+
+  for (i = 0; i < uiSTATEXP_VARS; ++i)
+  {
+    if (!statexp_set(uiVar + i, auiValue[i]))
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* statexp_set()                                                              */
+/*----------------------------------------------------------------------------*/
+static bool statexp_set(uint16_t uiVar, uint16_t uiValue) __naked
+{
+  (void) uiVar;
+  (void) uiValue;
+
+  __asm
+    ld   hl,2
+    add  hl,sp
+    ld   e,(hl)             ; E = variable
+    inc  hl
+    inc  hl
+    ld   c,(hl)             ; BC = value
+    inc  hl
+    ld   b,(hl)
+
+    push ix
+    push iy
+
+    ; Parameters of IDE_INTEGER_VAR are passed in the alternate registers
+    ld   h,0                ; H = 0: %a .. %z
+    ld   l,e                ; L = variable
+    ld   d,b                ; DE = value
+    ld   e,c
+    ld   b,1                ; B = 1: set
+    exx
+
+    ld   de,0x01C9          ; IDE_INTEGER_VAR (uiSTATEXP_IDE_INTEGER_VAR)
+    ld   c,7                ; RAM bank 7
+    rst  0x08
+    defb 0x94               ; M_P3DOS
+
+    pop  iy
+    pop  ix
+
+    ld   l,0
+    ret  nc                 ; Fc = 0: error
+    inc  l
+    ret
+  __endasm;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
@@ -0,0 +1,256 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: timer.c                                                            |
+| project:  ZX Spectrum Next - PING                                            |
+| author:   Stefan Zell                                                        |
+| date:     16/10/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Hardware time base of the application (CTC channels 0-4)                     |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 16/10/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <intrinsic.h>
+#include <arch/zxn.h>
+
+#include "sysclock.h"
+#include "timer.h"
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+CTC control word: timer mode, prescaler 16, time constant follows, reset
+*/
+#define uiCTC_TIMER (0x07)
+
+/*!
+CTC control word: counter mode, time constant follows, reset
+*/
+#define uiCTC_COUNTER (0x47)
+
+/*!
+CTC control word: reset (channel stopped)
+*/
+#define uiCTC_RESET (0x03)
+
+/*!
+Prescaler of channel 0 in timer mode
+*/
+#define uiCTC_PRESCALER (16)
+
+/*!
+Nominal tick rate of channel 0 [Hz] (28 MHz / 16 / 175)
+*/
+#define uiTIMER_RATE (10000)
+
+/*!
+Time constant of the counter channels: 256
+*/
+#define uiCTC_TC_COUNTER (0)
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+/*!
+Tick rate of channel 0 [Hz] minus uiTIMER_RATE; 0 on 28 MHz (VGA 0) and
+32 MHz, where the system clock divides down to exactly 10 kHz
+*/
+static int16_t g_iTimerError = 0;
+
+/*!
+Ports of the CTC channels used by the time base
+*/
+__sfr __banked __at 0x183B IO_TIMER_CTC0;
+__sfr __banked __at 0x193B IO_TIMER_CTC1;
+__sfr __banked __at 0x1A3B IO_TIMER_CTC2;
+__sfr __banked __at 0x1B3B IO_TIMER_CTC3;
+__sfr __banked __at 0x1C3B IO_TIMER_CTC4;
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/* timer_init()                                                               */
+/*----------------------------------------------------------------------------*/
+void timer_init(void)
+{
+  uint32_t uiClock = SYSCLOCK_HZ() / uiCTC_PRESCALER;
+  uint8_t  uiTc    = (uint8_t) ((uiClock + (uiTIMER_RATE / 2)) / uiTIMER_RATE);
+
+  g_iTimerError = (int16_t) (((uiClock + (uiTc >> 1)) / uiTc) - uiTIMER_RATE);
+
+  /* Counters first, so that all channels start at zero */
+  IO_TIMER_CTC4 = uiCTC_COUNTER;
+  IO_TIMER_CTC4 = uiCTC_TC_COUNTER;
+  IO_TIMER_CTC3 = uiCTC_COUNTER;
+  IO_TIMER_CTC3 = uiCTC_TC_COUNTER;
+  IO_TIMER_CTC2 = uiCTC_COUNTER;
+  IO_TIMER_CTC2 = uiCTC_TC_COUNTER;
+  IO_TIMER_CTC1 = uiCTC_COUNTER;
+  IO_TIMER_CTC1 = uiCTC_TC_COUNTER;
+
+  IO_TIMER_CTC0 = uiCTC_TIMER;
+  IO_TIMER_CTC0 = uiTc;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* timer_exit()                                                               */
+/*----------------------------------------------------------------------------*/
+void timer_exit(void)
+{
+  IO_TIMER_CTC0 = uiCTC_RESET;
+  IO_TIMER_CTC1 = uiCTC_RESET;
+  IO_TIMER_CTC2 = uiCTC_RESET;
+  IO_TIMER_CTC3 = uiCTC_RESET;
+  IO_TIMER_CTC4 = uiCTC_RESET;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* timer_now()                                                                */
+/*----------------------------------------------------------------------------*/
+uint32_t timer_now(void)
+{
+  uint8_t uiByte0;
+  uint8_t uiByte1;
+  uint8_t uiByte2;
+  uint8_t uiByte3;
+
+  /* Read again, if a carry rippled through the counters while reading */
+  do
+  {
+    uiByte3 = IO_TIMER_CTC4;
+    uiByte2 = IO_TIMER_CTC3;
+    uiByte1 = IO_TIMER_CTC2;
+    uiByte0 = IO_TIMER_CTC1;
+  }
+  while ((uiByte1 != IO_TIMER_CTC2) || (uiByte2 != IO_TIMER_CTC3) || (uiByte3 != IO_TIMER_CTC4));
+
+  /* The channels count down; 0 - value = number of elapsed pulses */
+  return (((uint32_t) ((uint8_t) (0 - uiByte3))) << 24) |
+         (((uint32_t) ((uint8_t) (0 - uiByte2))) << 16) |
+         (((uint16_t) ((uint8_t) (0 - uiByte1))) <<  8) |
+         ((uint8_t) (0 - uiByte0));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* timer_from_ms()                                                            */
+/*----------------------------------------------------------------------------*/
+uint32_t timer_from_ms(uint32_t uiMs)
+{
+  uint32_t uiTicks = uiMs * uiTIMER_TICKS_PER_MS;
+  uint32_t uiDelta;
+
+  if (0 == g_iTimerError)
+  {
+    return uiTicks;
+  }
+
+  /* uiMs * error / 1000, split so that the product fits into 32 bit */
+  if (0 < g_iTimerError)
+  {
+    uiDelta = ((uiMs / 1000) * g_iTimerError) + (((uiMs % 1000) * g_iTimerError) / 1000);
+    return uiTicks + uiDelta;
+  }
+
+  uiDelta = ((uiMs / 1000) * -g_iTimerError) + (((uiMs % 1000) * -g_iTimerError) / 1000);
+  return uiTicks - uiDelta;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* timer_to_100us()                                                           */
+/*----------------------------------------------------------------------------*/
+uint32_t timer_to_100us(uint32_t uiTicks)
+{
+  uint16_t uiRate = (uint16_t) (uiTIMER_RATE + g_iTimerError);
+  uint32_t uiDelta;
+
+  if (0 == g_iTimerError)
+  {
+    return uiTicks;
+  }
+
+  /* uiTicks * error / rate, split so that the product fits into 32 bit */
+  if (0 < g_iTimerError)
+  {
+    uiDelta = ((uiTicks / uiRate) * g_iTimerError) + (((uiTicks % uiRate) * g_iTimerError) / uiRate);
+    return uiTicks - uiDelta;
+  }
+
+  uiDelta = ((uiTicks / uiRate) * -g_iTimerError) + (((uiTicks % uiRate) * -g_iTimerError) / uiRate);
+  return uiTicks + uiDelta;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* timer_wait_until()                                                         */
+/*----------------------------------------------------------------------------*/
+void timer_wait_until(uint32_t uiDeadline)
+{
+  while (TIMER_BEFORE(timer_now(), uiDeadline))
+  {
+    intrinsic_nop();
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
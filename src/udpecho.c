@@ -0,0 +1,278 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: udpecho.c                                                          |
+| project:  ZX Spectrum Next - PING                                            |
+| author:   Stefan Zell                                                        |
+| date:     16/10/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Parser of the responses of the ESP8266 in multi-connection mode              |
+| (UDP echo probes, "-u port")                                                 |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 16/10/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "udpecho.h"
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+States of the parser
+*/
+#define UDPECHO_STATE_START (0x00) /* start of a line                    */
+#define UDPECHO_STATE_LINE  (0x01) /* inside of a line                   */
+#define UDPECHO_STATE_IPD   (0x02) /* header "+IPD,"                     */
+#define UDPECHO_STATE_LINK  (0x03) /* "+IPD,<link>"                      */
+#define UDPECHO_STATE_LEN   (0x04) /* "+IPD,<link>,<len>"                */
+#define UDPECHO_STATE_DATA  (0x05) /* data of "+IPD"                     */
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+/*!
+Header of received data
+*/
+static const char g_acIpd[] = "+IPD,";
+
+/*!
+Lines in the order of the events UDPECHO_EVENT_OK, UDPECHO_EVENT_ERROR, ...
+*/
+static const char* const g_acKeyword[] =
+{
+  "OK",
+  "ERROR",
+  "SEND OK",
+  "SEND FAIL"
+};
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+/*!
+Classify the line that ends
+@return Event of the line (UDPECHO_EVENT_NONE if the line has no meaning)
+*/
+static udpecho_event_t udpecho_line(udpecho_parser_t* pParser);
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/* udpecho_reset()                                                            */
+/*----------------------------------------------------------------------------*/
+void udpecho_reset(udpecho_parser_t* pParser)
+{
+  pParser->uiState = UDPECHO_STATE_START;
+  pParser->uiPos   = 0;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* udpecho_parse()                                                            */
+/*----------------------------------------------------------------------------*/
+udpecho_event_t udpecho_parse(udpecho_parser_t* pParser, uint8_t uiByte)
+{
+  udpecho_event_t eEvent = UDPECHO_EVENT_NONE;
+
+  switch (pParser->uiState)
+  {
+    case UDPECHO_STATE_DATA:
+      /* "P<seq>"; the data may contain any byte, even CR/LF */
+      if (0 == pParser->uiPos)
+      {
+        pParser->bProbe = ('P' == uiByte);
+        pParser->uiSeq  = 0;
+      }
+      else if (('0' <= uiByte) && ('9' >= uiByte))
+      {
+        pParser->uiSeq = (pParser->uiSeq * 10) + (uiByte - '0');
+      }
+      else
+      {
+        pParser->bProbe = false;
+      }
+
+      ++pParser->uiPos;
+
+      if (0 == --pParser->uiLen)
+      {
+        pParser->bProbe = (pParser->bProbe && (uiUDPECHO_PROBE_LEN == pParser->uiPos));
+        udpecho_reset(pParser);
+        eEvent = UDPECHO_EVENT_DATA;
+      }
+      break;
+
+    case UDPECHO_STATE_IPD:
+      if (g_acIpd[pParser->uiPos] == (char) uiByte)
+      {
+        if ('\0' == g_acIpd[++pParser->uiPos])
+        {
+          pParser->uiState = UDPECHO_STATE_LINK;
+          pParser->uiLink  = 0;
+        }
+      }
+      else
+      {
+        pParser->uiState = UDPECHO_STATE_LINE;
+        pParser->uiPos   = uiUDPECHO_LINE + 1;
+      }
+      break;
+
+    case UDPECHO_STATE_LINK:
+      if (('0' <= uiByte) && ('9' >= uiByte))
+      {
+        pParser->uiLink = (pParser->uiLink * 10) + (uiByte - '0');
+      }
+      else if (',' == uiByte)
+      {
+        pParser->uiState = UDPECHO_STATE_LEN;
+        pParser->uiLen   = 0;
+      }
+      else
+      {
+        pParser->uiState = UDPECHO_STATE_LINE;
+        pParser->uiPos   = uiUDPECHO_LINE + 1;
+      }
+      break;
+
+    case UDPECHO_STATE_LEN:
+      if (('0' <= uiByte) && ('9' >= uiByte))
+      {
+        pParser->uiLen = (pParser->uiLen * 10) + (uiByte - '0');
+      }
+      else if ((':' == uiByte) && (0 != pParser->uiLen))
+      {
+        pParser->uiState = UDPECHO_STATE_DATA;
+        pParser->uiPos   = 0;
+      }
+      else
+      {
+        pParser->uiState = UDPECHO_STATE_LINE;
+        pParser->uiPos   = uiUDPECHO_LINE + 1;
+      }
+      break;
+
+    default: /* UDPECHO_STATE_START, UDPECHO_STATE_LINE */
+      if ('\r' == uiByte)
+      {
+        /* ignored */
+      }
+      else if ('\n' == uiByte)
+      {
+        eEvent = udpecho_line(pParser);
+        udpecho_reset(pParser);
+      }
+      else if (UDPECHO_STATE_START == pParser->uiState)
+      {
+        if ('+' == uiByte)
+        {
+          pParser->uiState = UDPECHO_STATE_IPD;
+          pParser->uiPos   = 1;
+        }
+        else if ('>' == uiByte)
+        {
+          /* The prompt is not terminated by a line feed */
+          pParser->uiState = UDPECHO_STATE_LINE;
+          pParser->uiPos   = uiUDPECHO_LINE + 1;
+          eEvent = UDPECHO_EVENT_PROMPT;
+        }
+        else
+        {
+          pParser->uiState  = UDPECHO_STATE_LINE;
+          pParser->acLine[0] = (char) uiByte;
+          pParser->uiPos    = 1;
+        }
+      }
+      else if (pParser->uiPos < uiUDPECHO_LINE)
+      {
+        pParser->acLine[pParser->uiPos++] = (char) uiByte;
+      }
+      break;
+  }
+
+  return eEvent;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* udpecho_line()                                                             */
+/*----------------------------------------------------------------------------*/
+static udpecho_event_t udpecho_line(udpecho_parser_t* pParser)
+{
+  uint8_t i;
+
+  /* Lines that are skipped have a position behind the buffer, longer lines
+     are truncated */
+  if ((UDPECHO_STATE_LINE != pParser->uiState) || (uiUDPECHO_LINE < pParser->uiPos))
+  {
+    return UDPECHO_EVENT_NONE;
+  }
+
+  pParser->acLine[pParser->uiPos] = '\0';
+
+  for (i = 0; i < (sizeof(g_acKeyword) / sizeof(g_acKeyword[0])); ++i)
+  {
+    if (0 == strcmp(pParser->acLine, g_acKeyword[i]))
+    {
+      return (udpecho_event_t) (UDPECHO_EVENT_OK + i);
+    }
+  }
+
+  return (0 == strncmp(pParser->acLine, "busy ", 5) ? UDPECHO_EVENT_BUSY : UDPECHO_EVENT_NONE);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
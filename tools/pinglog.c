@@ -0,0 +1,166 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: pinglog.c                                                          |
+| project:  ZX Spectrum Next - PING                                            |
+| author:   Stefan Zell                                                        |
+| date:     16/10/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Converts the binary log of PING (option "-o") to CSV                         |
+| (build: "make -C build tools", usage: "pinglog file.log > file.csv")         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 16/10/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+Size of a record of the log file [bytes]
+*/
+#define uiRECORD_SIZE (8)
+
+/*!
+Result code of the first record of a run (see "reclog.h")
+*/
+#define uiRESULT_START (0xFF)
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+/*!
+Names of the result codes (see "uiRECLOG_RESULT_xxx")
+*/
+static const char* g_acResult[] = { "ok", "timeout", "busy", "error", "comm" };
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/* main()                                                                     */
+/*----------------------------------------------------------------------------*/
+int main(int argc, char* argv[])
+{
+  FILE* pFile;
+  uint8_t auiRecord[uiRECORD_SIZE];
+  unsigned long uiRun = 0;
+  unsigned long uiSeq = 0;
+  unsigned long uiRecords = 0;
+
+  if (2 != argc)
+  {
+    fprintf(stderr, "usage: %s file.log > file.csv\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  if (0 == (pFile = fopen(argv[1], "rb")))
+  {
+    fprintf(stderr, "%s: %s\n", argv[1], strerror(errno));
+    return EXIT_FAILURE;
+  }
+
+  printf("run,seq,time_ms,rtt_ms,result\n");
+
+  while (sizeof(auiRecord) == fread(auiRecord, 1, sizeof(auiRecord), pFile))
+  {
+    /* Little endian: time [100 us], rtt [ms], seq (lower 8 bits), result */
+    uint32_t uiTime   = ((uint32_t) auiRecord[0])       | ((uint32_t) auiRecord[1] << 8) |
+                        ((uint32_t) auiRecord[2] << 16) | ((uint32_t) auiRecord[3] << 24);
+    uint16_t uiRtt    = (uint16_t) (auiRecord[4] | (auiRecord[5] << 8));
+    uint8_t  uiSeq8   = auiRecord[6];
+    uint8_t  uiResult = auiRecord[7];
+
+    ++uiRecords;
+
+    if (uiRESULT_START == uiResult)
+    {
+      ++uiRun;
+      uiSeq = 0;
+      fprintf(stderr, "run %lu: interval %u ms%s\n", uiRun, uiRtt, (uiSeq8 & 0x01 ? ", fixed rate" : ""));
+      continue;
+    }
+
+    /* Extend the sequence number; gaps show lost records */
+    uiSeq += (uint8_t) (uiSeq8 - (uint8_t) uiSeq);
+
+    printf("%lu,%lu,%lu.%lu,%u,%s\n",
+           uiRun, uiSeq,
+           (unsigned long) (uiTime / 10), (unsigned long) (uiTime % 10),
+           uiRtt,
+           (uiResult < (sizeof(g_acResult) / sizeof(g_acResult[0])) ? g_acResult[uiResult] : "?"));
+  }
+
+  if (ferror(pFile))
+  {
+    fprintf(stderr, "%s: %s\n", argv[1], strerror(errno));
+    fclose(pFile);
+    return EXIT_FAILURE;
+  }
+
+  fprintf(stderr, "%lu records\n", uiRecords);
+  fclose(pFile);
+
+  return EXIT_SUCCESS;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/